@@ -0,0 +1,53 @@
+/// @file bench_attacks.cpp
+/// Full attack maps, as the evaluation builds them, over a few typical
+/// positions.
+
+#include <chessie/attacks.hpp>
+#include <chessie/magic.hpp>
+#include <chessie/position.hpp>
+
+#include <benchmark/benchmark.h>
+
+#include <array>
+#include <cstdint>
+#include <vector>
+
+namespace {
+
+using namespace chessie;
+
+/// Piece bitboards of a handful of opening, middlegame and endgame
+/// positions.
+const std::vector<PieceBitboards>& positions() {
+    static const std::vector<PieceBitboards> cases = [] {
+        magic::init();
+        constexpr std::array kFens = {
+            "rnbqkbnr/pppppppp/8/8/8/8/PPPPPPPP/RNBQKBNR w KQkq - 0 1",
+            "r3k2r/p1ppqpb1/bn2pnp1/3PN3/1p2P3/2N2Q1p/PPPBBPPP/R3K2R w KQkq - 0 1",
+            "r1bq1rk1/pp2bppp/2n1pn2/3p4/2PP4/2N1PN2/PP2BPPP/R2QKB1R w KQ - 0 8",
+            "2r3k1/1q3ppp/p3p3/1p1nP3/3Q4/P4N2/1P3PPP/3R2K1 w - - 0 25",
+            "8/5pk1/3r2p1/p7/P1R5/6P1/5PK1/8 w - - 0 40",
+        };
+        std::vector<PieceBitboards> out;
+        for (const char* fen : kFens) {
+            out.push_back(piece_bitboards(Position::from_fen(fen).board()));
+        }
+        return out;
+    }();
+    return cases;
+}
+
+void BM_ComputeAttacks(benchmark::State& state) {
+    const auto& cases = positions();
+    AttackMap map;
+    for (auto _ : state) {
+        for (const PieceBitboards& pieces : cases) {
+            compute_attacks(pieces, map);
+            benchmark::DoNotOptimize(map);
+        }
+    }
+    state.SetItemsProcessed(state.iterations() * static_cast<std::int64_t>(cases.size()));
+}
+BENCHMARK(BM_ComputeAttacks);
+
+}  // namespace
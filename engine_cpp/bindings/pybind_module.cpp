@@ -6,9 +6,15 @@
 
 #include <chessie/bitboard.hpp>
 #include <chessie/engine.hpp>
+#include <chessie/engine_pool.hpp>
 #include <chessie/magic.hpp>
+#include <chessie/trace.hpp>
 
+#include <chrono>
+#include <exception>
+#include <memory>
 #include <mutex>
+#include <optional>
 #include <pybind11/pybind11.h>
 #include <pybind11/stl.h>
 #include <string>
@@ -25,6 +31,33 @@ void ensure_magic_init() {
     std::call_once(g_magic_init_flag, chessie::magic::init);
 }
 
+/// Deletes an engine with the GIL released: its destructor waits for the
+/// search thread, which may need the GIL to run a Python callback.
+struct ReleaseGilDelete {
+    void operator()(chessie::Engine* engine) const {
+        py::gil_scoped_release release;
+        delete engine;
+    }
+};
+
+/// `(has_move, from_sq, to_sq, move_flag, promotion, score_cp, depth, nodes)`.
+py::tuple result_tuple(const chessie::SearchResult& result) {
+    const bool has_move = !result.best_move.is_null();
+    return py::make_tuple(has_move, static_cast<int>(result.best_move.from_sq),
+                          static_cast<int>(result.best_move.to_sq),
+                          static_cast<int>(result.best_move.flag),
+                          static_cast<int>(result.best_move.promotion), result.score_cp,
+                          result.depth, static_cast<int64_t>(result.nodes));
+}
+
+chessie::SearchLimits make_limits(int max_depth, int64_t time_limit_ms, std::uint64_t max_nodes) {
+    chessie::SearchLimits limits;
+    limits.max_depth = max_depth;
+    limits.time_limit_ms = time_limit_ms;
+    limits.max_nodes = max_nodes;
+    return limits;
+}
+
 }  // namespace
 
 PYBIND11_MODULE(_chessie_engine, m) {
@@ -45,45 +78,239 @@ PYBIND11_MODULE(_chessie_engine, m) {
         },
         py::arg("bitboard"), "Return set-bit squares in ascending order (LSB -> MSB).");
 
+    // ── Tracing ─────────────────────────────────────────────────────────
+    m.def(
+        "trace_enabled", [] { return chessie::trace::kEnabled; },
+        "True if the module was built with CHESSIE_TRACE spans.");
+
+    m.def("trace_json", &chessie::trace::dump_json,
+          "Recorded spans as a Chrome trace-event JSON string.");
+
+    m.def("trace_write", &chessie::trace::write_json, py::arg("path"),
+          "Write recorded spans as Chrome trace JSON to *path*. Returns False on I/O error.");
+
+    m.def("trace_clear", &chessie::trace::clear, "Drop all recorded spans.");
+
+    // ── Asynchronous search handle ──────────────────────────────────────
+    py::class_<chessie::SearchHandle, std::shared_ptr<chessie::SearchHandle>>(m, "SearchHandle")
+        .def("poll", &chessie::SearchHandle::poll, "True once the search has finished.")
+
+        .def("stop", &chessie::SearchHandle::stop,
+             "Ask the search to stop as soon as possible. Returns immediately.")
+
+        .def(
+            "wait",
+            [](const chessie::SearchHandle& self, std::optional<double> timeout_s) {
+                py::gil_scoped_release release;
+                if (!timeout_s) {
+                    self.wait();
+                    return true;
+                }
+                const auto ms = static_cast<std::int64_t>(*timeout_s * 1000.0);
+                return self.wait(std::chrono::milliseconds(ms));
+            },
+            py::arg("timeout") = py::none(),
+            "Block until the search finishes, or at most *timeout* seconds. "
+            "Returns True if it has finished.")
+
+        .def(
+            "result",
+            [](const chessie::SearchHandle& self) -> py::object {
+                if (!self.poll())
+                    return py::none();
+                if (self.error())
+                    std::rethrow_exception(self.error());
+                return result_tuple(self.result());
+            },
+            "The search result tuple (as returned by ``Engine.search``), or None while running. "
+            "Raises the search's error if it failed.");
+
     // ── Engine class ────────────────────────────────────────────────────
-    py::class_<chessie::Engine>(m, "Engine")
+    py::class_<chessie::Engine, std::unique_ptr<chessie::Engine, ReleaseGilDelete>>(m, "Engine")
         .def(py::init<std::size_t>(), py::arg("tt_mb") = 64,
              "Create an engine with a transposition table of *tt_mb* megabytes.")
 
         .def(
             "search",
             [](chessie::Engine& self, const std::string& fen, int max_depth,
-               int64_t time_limit_ms) -> py::tuple {
+               int64_t time_limit_ms, std::uint64_t max_nodes) -> py::tuple {
+                CHESSIE_TRACE_SCOPE("py.search");
                 chessie::Position pos = chessie::Position::from_fen(fen);
-                chessie::SearchLimits limits;
-                limits.max_depth = max_depth;
-                limits.time_limit_ms = time_limit_ms;
+                const chessie::SearchLimits limits =
+                    make_limits(max_depth, time_limit_ms, max_nodes);
 
                 chessie::SearchResult result;
                 {
                     // Release the GIL during the search so Python threads
                     // (e.g. the cancel callback) can run concurrently.
-                    py::gil_scoped_release release;
+                    std::optional<py::gil_scoped_release> release(std::in_place);
                     result = self.search(pos, limits);
-                }
 
-                const bool has_move = !result.best_move.is_null();
-                return py::make_tuple(has_move, static_cast<int>(result.best_move.from_sq),
-                                      static_cast<int>(result.best_move.to_sq),
-                                      static_cast<int>(result.best_move.flag),
-                                      static_cast<int>(result.best_move.promotion), result.score_cp,
-                                      result.depth, static_cast<int64_t>(result.nodes));
+                    // Time spent waiting to reacquire the GIL.
+                    CHESSIE_TRACE_SCOPE("py.gil_acquire");
+                    release.reset();
+                }
+                return result_tuple(result);
             },
             py::arg("fen"), py::arg("max_depth") = 64, py::arg("time_limit_ms") = -1,
+            py::arg("max_nodes") = 0,
             R"doc(Run an alpha-beta search on the position given by *fen*.
 
 Returns a tuple ``(has_move, from_sq, to_sq, move_flag, promotion, score_cp, depth, nodes)``.
 *has_move* is ``False`` when the position is already checkmate or stalemate.)doc")
 
+        .def(
+            "start_search",
+            [](chessie::Engine& self, const std::string& fen, int max_depth,
+               int64_t time_limit_ms, std::uint64_t max_nodes,
+               std::optional<py::function> on_done) {
+                const chessie::Position pos = chessie::Position::from_fen(fen);
+                const chessie::SearchLimits limits =
+                    make_limits(max_depth, time_limit_ms, max_nodes);
+
+                chessie::SearchCallback callback;
+                if (on_done) {
+                    // The Python callable may be released on the search
+                    // thread, so its last reference is dropped under the GIL.
+                    std::shared_ptr<py::function> fn(new py::function(std::move(*on_done)),
+                                                     [](py::function* f) {
+                                                         py::gil_scoped_acquire gil;
+                                                         delete f;
+                                                     });
+                    callback = [fn](const chessie::SearchResult& result) {
+                        py::gil_scoped_acquire gil;
+                        try {
+                            (*fn)(result_tuple(result));
+                        } catch (py::error_already_set& e) {
+                            e.discard_as_unraisable("Engine.start_search callback");
+                        }
+                    };
+                }
+
+                // Starting may join a previous search whose callback needs the GIL.
+                py::gil_scoped_release release;
+                return self.start_search(pos, limits, std::move(callback));
+            },
+            py::arg("fen"), py::arg("max_depth") = 64, py::arg("time_limit_ms") = -1,
+            py::arg("max_nodes") = 0, py::arg("on_done") = py::none(),
+            R"doc(Start searching *fen* on the engine's own thread and return a ``SearchHandle``.
+
+A search still running on this engine is stopped first. *on_done*, if given, is called with
+the result tuple on the search thread (holding the GIL) after the handle reports completion;
+it may start another search. Dropping the engine stops the search.)doc")
+
+        .def(
+            "last_stats",
+            [](chessie::Engine& self) -> py::dict {
+                // Stopping a running search may wait for a callback that
+                // needs the GIL.
+                chessie::SearchResult last;
+                {
+                    py::gil_scoped_release release;
+                    last = self.last_result();
+                }
+                const chessie::SearchStats& stats = last.stats;
+                py::list iterations;
+                for (const chessie::IterationStats& it : stats.iterations) {
+                    py::dict row;
+                    row["depth"] = it.depth;
+                    row["seldepth"] = it.seldepth;
+                    row["nodes"] = it.nodes;
+                    row["ebf"] = it.ebf;
+                    row["time_ms"] = it.time_ms;
+                    row["nps"] = it.nps;
+                    row["hashfull"] = it.hashfull;
+                    row["best_move_node_fraction"] = it.best_move_node_fraction;
+                    iterations.append(row);
+                }
+                py::list root_moves;
+                for (const chessie::RootMove& rm : last.root_moves) {
+                    py::list pv;
+                    for (const chessie::Move& m : rm.pv) pv.append(m.uci());
+                    py::dict row;
+                    row["move"] = rm.move.uci();
+                    row["score"] = rm.score;
+                    row["previous_score"] = rm.previous_score;
+                    row["nodes"] = rm.nodes;
+                    row["pv"] = pv;
+                    root_moves.append(row);
+                }
+
+                const chessie::SearchResult& result = last;
+                py::dict out;
+                out["enabled"] = chessie::kSearchStats;
+                out["depth"] = result.depth;
+                out["seldepth"] = result.seldepth;
+                out["nodes"] = result.nodes;
+                out["time_ms"] = result.time_ms;
+                out["nps"] = result.nps;
+                out["hashfull"] = result.hashfull;
+                out["qnodes"] = stats.qnodes;
+                out["tt_probes"] = stats.tt_probes;
+                out["tt_hits"] = stats.tt_hits;
+                out["tt_cutoffs"] = stats.tt_cutoffs;
+                out["null_tries"] = stats.null_tries;
+                out["null_cutoffs"] = stats.null_cutoffs;
+                out["lmr_researches"] = stats.lmr_researches;
+                out["futility_prunes"] = stats.futility_prunes;
+                out["reverse_futility_prunes"] = stats.reverse_futility_prunes;
+                out["razor_prunes"] = stats.razor_prunes;
+                out["probcut_prunes"] = stats.probcut_prunes;
+                out["beta_cutoffs"] = stats.beta_cutoffs;
+                out["first_move_cutoffs"] = stats.first_move_cutoffs;
+                out["first_move_cutoff_rate"] = stats.first_move_cutoff_rate();
+                out["lazy_evals"] = stats.eval.lazy;
+                out["full_evals"] = stats.eval.full;
+                out["iterations"] = iterations;
+                out["root_moves"] = root_moves;
+                out["best_move_node_fraction"] = result.best_move_node_fraction();
+                return out;
+            },
+            R"doc(Statistics of the most recent search as a dict. A running search is stopped first.
+
+Always includes depth, seldepth, nodes, time_ms, nps, hashfull, the per-iteration rows
+and ``root_moves`` (move, score, previous_score, subtree nodes and PV per root move,
+best first) with the best move's node fraction. Counters are zero when the module was
+built with ``SEARCH_STATS=OFF`` (``enabled`` is then ``False``); ``iterations`` and
+``root_moves`` are always filled.)doc")
+
         .def("cancel", &chessie::Engine::cancel, "Cancel a running search (thread-safe).")
 
+        // These stop a running search first, which may wait for a callback
+        // that needs the GIL.
+        .def("set_heuristic_aging", &chessie::Engine::set_heuristic_aging, py::arg("enabled"),
+             py::call_guard<py::gil_scoped_release>(),
+             "Age killers and history between searches instead of clearing them.")
+
         .def("set_tt_size", &chessie::Engine::set_tt_size, py::arg("mb"),
-             "Resize the transposition table (clears it).")
+             py::call_guard<py::gil_scoped_release>(),
+             "Resize the transposition table, keeping its entries where possible.")
+
+        .def("clear_tt", &chessie::Engine::clear_tt, py::call_guard<py::gil_scoped_release>(),
+             "Clear the transposition table.");
+
+    // ── Engine pool ─────────────────────────────────────────────────────
+    py::class_<chessie::EnginePool>(m, "EnginePool")
+        .def(py::init<std::size_t, std::size_t>(), py::arg("budget_mb"), py::arg("contexts"),
+             "Create *contexts* engines sharing one transposition table, all within "
+             "*budget_mb* megabytes.")
+
+        .def("engine", &chessie::EnginePool::engine, py::arg("index"),
+             py::return_value_policy::reference_internal,
+             "Search context *index*; valid while the pool is alive.")
+
+        .def("__len__", &chessie::EnginePool::size)
+
+        .def_property_readonly("budget_mb", &chessie::EnginePool::budget_mb)
+
+        .def("memory_bytes", &chessie::EnginePool::memory_bytes,
+             "Bytes charged to the shared table and all contexts, per-context "
+             "reserves included.")
+
+        .def("set_budget", &chessie::EnginePool::set_budget, py::arg("mb"),
+             py::call_guard<py::gil_scoped_release>(),
+             "Change the memory budget, keeping table entries. Running searches are stopped.")
 
-        .def("clear_tt", &chessie::Engine::clear_tt, "Clear the transposition table.");
+        .def("clear_tt", &chessie::EnginePool::clear_tt, py::call_guard<py::gil_scoped_release>(),
+             "Clear the shared transposition table. Running searches are stopped.");
 }
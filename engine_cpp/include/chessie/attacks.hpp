@@ -0,0 +1,48 @@
+#pragma once
+
+/// @file attacks.hpp
+/// Attack maps for the attack-dependent evaluation terms.
+///
+/// An `AttackMap` holds the squares attacked by each side, split by piece
+/// type, plus the attack set of every piece. A full evaluation builds one
+/// and reads every mobility and king-safety term from it; the lazy tier
+/// skips it. Check detection uses the position's incrementally kept
+/// checkers, which are cheaper than a full map.
+///
+/// Requires magic::init() to have been called first.
+
+#include <chessie/bitboard.hpp>
+#include <chessie/board.hpp>
+#include <chessie/types.hpp>
+
+#include <array>
+
+namespace chessie {
+
+/// Per-colour piece bitboards, [color_index][piece_index].
+using PieceBitboards = std::array<std::array<Bitboard, kNumPieceTypes>, 2>;
+
+/// Copy a board's piece bitboards.
+[[nodiscard]] PieceBitboards piece_bitboards(const Board& board) noexcept;
+
+/// Attack sets of both sides for one position.
+struct AttackMap {
+    /// Index of the all-pieces union in `attacked_by`.
+    static constexpr int kAllPieces = kNumPieceTypes;
+
+    /// Squares attacked by [color_index][Pawn=0 .. King=5, kAllPieces].
+    Bitboard attacked_by[2][kNumPieceTypes + 1]{};
+
+    /// Attack set of the piece on each square. Only meaningful for squares
+    /// holding a knight, bishop, rook, queen or king (left uninitialised
+    /// elsewhere to keep per-node construction cheap).
+    Bitboard attacks_from[64];
+};
+
+/// Compute the attack map of both sides.
+void compute_attacks(const PieceBitboards& pieces, AttackMap& map) noexcept;
+
+/// Compute the attack map of both sides of `board`.
+[[nodiscard]] AttackMap compute_attacks(const Board& board) noexcept;
+
+}  // namespace chessie
@@ -120,6 +120,13 @@ inline constexpr Bitboard kRank8 = kRank1 << 56;
     return (b >> 9) & ~kFileH;
 }
 
+/// Mirror vertically (rank 1 ↔ rank 8): square `sq` moves to `sq ^ 56`.
+[[nodiscard]] constexpr Bitboard flip_vertical(Bitboard b) noexcept {
+    b = ((b >> 8) & 0x00FF00FF00FF00FFULL) | ((b & 0x00FF00FF00FF00FFULL) << 8);
+    b = ((b >> 16) & 0x0000FFFF0000FFFFULL) | ((b & 0x0000FFFF0000FFFFULL) << 16);
+    return (b >> 32) | (b << 32);
+}
+
 // ── Pre-computed attack tables for non-sliding pieces ───────────────────────
 
 namespace detail {
@@ -181,9 +188,48 @@ constexpr auto compute_pawn_attacks() noexcept {
     return r;
 }
 
+constexpr auto compute_line_tables() noexcept {
+    struct Result {
+        Bitboard between[64][64]{};
+        Bitboard line[64][64]{};
+        Bitboard rays[2][64]{};  ///< [0] = rook, [1] = bishop, on an empty board.
+    };
+    constexpr int kDirections[8][2] = {{1, 0},  {-1, 0}, {0, 1},  {0, -1},
+                                       {1, 1},  {1, -1}, {-1, 1}, {-1, -1}};
+    auto on_board = [](int file, int rank) {
+        return file >= 0 && file < 8 && rank >= 0 && rank < 8;
+    };
+    auto ray = [&](int sq, int df, int dr) {
+        Bitboard bb = kEmptyBB;
+        for (int f = sq % 8 + df, r = sq / 8 + dr; on_board(f, r); f += df, r += dr) {
+            bb |= square_bb(static_cast<Square>(r * 8 + f));
+        }
+        return bb;
+    };
+    Result r{};
+    for (int sq = 0; sq < 64; ++sq) {
+        for (int dir = 0; dir < 8; ++dir) {
+            const auto& d = kDirections[dir];
+            r.rays[dir < 4 ? 0 : 1][sq] |= ray(sq, d[0], d[1]);
+            const Bitboard full =
+                ray(sq, d[0], d[1]) | ray(sq, -d[0], -d[1]) | square_bb(static_cast<Square>(sq));
+            Bitboard between = kEmptyBB;
+            for (int f = sq % 8 + d[0], rk = sq / 8 + d[1]; on_board(f, rk);
+                 f += d[0], rk += d[1]) {
+                const int to = rk * 8 + f;
+                r.between[sq][to] = between;
+                r.line[sq][to] = full;
+                between |= square_bb(static_cast<Square>(to));
+            }
+        }
+    }
+    return r;
+}
+
 inline constexpr auto kKnightAttacksData = compute_knight_attacks();
 inline constexpr auto kKingAttacksData = compute_king_attacks();
 inline constexpr auto kPawnAttacksData = compute_pawn_attacks();
+inline constexpr auto kLineData = compute_line_tables();
 
 }  // namespace detail
 
@@ -202,4 +248,33 @@ inline constexpr auto kPawnAttacksData = compute_pawn_attacks();
     return detail::kPawnAttacksData.table[color_index(c)][sq];
 }
 
+// ── Lines ───────────────────────────────────────────────────────────────────
+
+/// Squares strictly between `a` and `b` when they share a rank, file or
+/// diagonal; empty otherwise.
+[[nodiscard]] constexpr Bitboard between_bb(Square a, Square b) noexcept {
+    return detail::kLineData.between[a][b];
+}
+
+/// The whole rank, file or diagonal through `a` and `b`, edge to edge;
+/// empty if they share none.
+[[nodiscard]] constexpr Bitboard line_bb(Square a, Square b) noexcept {
+    return detail::kLineData.line[a][b];
+}
+
+/// Rook moves from `sq` on an empty board.
+[[nodiscard]] constexpr Bitboard rook_rays(Square sq) noexcept {
+    return detail::kLineData.rays[0][sq];
+}
+
+/// Bishop moves from `sq` on an empty board.
+[[nodiscard]] constexpr Bitboard bishop_rays(Square sq) noexcept {
+    return detail::kLineData.rays[1][sq];
+}
+
+/// Do `a`, `b` and `c` lie on one rank, file or diagonal?
+[[nodiscard]] constexpr bool aligned(Square a, Square b, Square c) noexcept {
+    return test_bit(line_bb(a, b), c);
+}
+
 }  // namespace chessie
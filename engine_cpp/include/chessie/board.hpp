@@ -16,7 +16,10 @@ namespace chessie {
 /// Maintains 12 piece bitboards (2 colors × 6 piece types),
 /// aggregate occupancy bitboards, and a 64-element mailbox
 /// for O(1) piece-at-square lookups.
-class Board {
+///
+/// The mailbox holds one-byte piece codes, so it fills exactly one cache
+/// line and the bitboards the next two: a whole board is three lines.
+class alignas(64) Board {
    public:
     Board() noexcept { clear(); }
 
@@ -29,48 +32,58 @@ class Board {
         set_bit(pieces_[ci][pi], sq);
         set_bit(occupied_[ci], sq);
         set_bit(occupied_all_, sq);
-        mailbox_[sq] = p;
+        mailbox_[sq] = p.code();
     }
 
     /// Remove a piece from the board. Square must be occupied.
     void remove_piece(Square sq) noexcept {
-        Piece p = mailbox_[sq];
-        int ci = color_index(p.color);
-        int pi = piece_index(p.type);
+        PieceCode code = mailbox_[sq];
+        int ci = code >> 3;
+        int pi = (code & 7) - 1;
         clear_bit(pieces_[ci][pi], sq);
         clear_bit(occupied_[ci], sq);
         clear_bit(occupied_all_, sq);
-        mailbox_[sq] = kNoPiece;
+        mailbox_[sq] = kNoPieceCode;
     }
 
     /// Move a piece from one square to another. `from` must be occupied, `to` must be empty.
     void move_piece(Square from, Square to) noexcept {
-        Piece p = mailbox_[from];
-        int ci = color_index(p.color);
-        int pi = piece_index(p.type);
+        PieceCode code = mailbox_[from];
+        int ci = code >> 3;
+        int pi = (code & 7) - 1;
         Bitboard mask = square_bb(from) | square_bb(to);
         pieces_[ci][pi] ^= mask;
         occupied_[ci] ^= mask;
         occupied_all_ ^= mask;
-        mailbox_[to] = p;
-        mailbox_[from] = kNoPiece;
+        mailbox_[to] = code;
+        mailbox_[from] = kNoPieceCode;
     }
 
     // ── Queries ─────────────────────────────────────────────────────────
 
     /// Piece at a given square (kNoPiece if empty).
-    [[nodiscard]] Piece piece_at(Square sq) const noexcept { return mailbox_[sq]; }
+    [[nodiscard]] Piece piece_at(Square sq) const noexcept {
+        return Piece::from_code(mailbox_[sq]);
+    }
 
-    /// Whether a square is empty.
-    [[nodiscard]] bool is_empty(Square sq) const noexcept {
-        return mailbox_[sq].type == PieceType::None;
+    /// Type of the piece at a given square (PieceType::None if empty).
+    [[nodiscard]] PieceType type_at(Square sq) const noexcept {
+        return static_cast<PieceType>(mailbox_[sq] & 7);
     }
 
+    /// Whether a square is empty.
+    [[nodiscard]] bool is_empty(Square sq) const noexcept { return mailbox_[sq] == kNoPieceCode; }
+
     /// Bitboard of all pieces of a given color and type.
     [[nodiscard]] Bitboard pieces(Color c, PieceType pt) const noexcept {
         return pieces_[color_index(c)][piece_index(pt)];
     }
 
+    /// Bitboard of all pieces of a given type, both colors.
+    [[nodiscard]] Bitboard pieces(PieceType pt) const noexcept {
+        return pieces_[0][piece_index(pt)] | pieces_[1][piece_index(pt)];
+    }
+
     /// Bitboard of all pieces of a given color.
     [[nodiscard]] Bitboard occupied(Color c) const noexcept { return occupied_[color_index(c)]; }
 
@@ -94,7 +107,7 @@ class Board {
         occupied_[1] = kEmptyBB;
         occupied_all_ = kEmptyBB;
         for (auto& sq : mailbox_) {
-            sq = kNoPiece;
+            sq = kNoPieceCode;
         }
     }
 
@@ -114,10 +127,14 @@ class Board {
     [[nodiscard]] static Board initial() noexcept;
 
    private:
+    static constexpr PieceCode kNoPieceCode = kNoPiece.code();
+
+    PieceCode mailbox_[64]{};  // Piece::code() per square
     Bitboard pieces_[2][6]{};  // [color_index][piece_index]
     Bitboard occupied_[2]{};   // [color_index]
     Bitboard occupied_all_{};
-    Piece mailbox_[64]{};
 };
 
+static_assert(sizeof(Board) == 192, "Board should span exactly three cache lines");
+
 }  // namespace chessie
@@ -5,29 +5,158 @@
 
 #include <chessie/search.hpp>
 
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
 #include <cstddef>
+#include <exception>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <optional>
+#include <thread>
 
 namespace chessie {
 
+class EnginePool;
+
+/// Completion callback of an asynchronous search. Runs on the engine's
+/// search thread once the handle reports completion. It may start another
+/// search or destroy the engine.
+using SearchCallback = std::function<void(const SearchResult&)>;
+
+/// A search started with `Engine::start_search`. Shared by the caller and
+/// the engine, so it stays valid after either lets go of it.
+class SearchHandle {
+   public:
+    /// True once the search has finished and `result()` is available.
+    [[nodiscard]] bool poll() const noexcept { return done_.load(std::memory_order_acquire); }
+
+    /// Ask the search to stop as soon as possible. Returns immediately.
+    void stop() noexcept { stop_.store(true, std::memory_order_relaxed); }
+
+    /// Block until the search has finished.
+    void wait() const;
+
+    /// Block for at most `timeout`. Returns true if the search has finished.
+    bool wait(std::chrono::milliseconds timeout) const;
+
+    /// Result of the finished search. Only valid once `poll()` is true.
+    [[nodiscard]] const SearchResult& result() const noexcept { return result_; }
+
+    /// The exception the search failed with (e.g. std::bad_alloc while
+    /// allocating the table), or null. Only valid once `poll()` is true.
+    [[nodiscard]] std::exception_ptr error() const noexcept { return error_; }
+
+   private:
+    friend class Engine;
+
+    void finish(SearchResult result, std::exception_ptr error);
+
+    std::atomic<bool> stop_{false};
+    std::atomic<bool> done_{false};
+    mutable std::mutex mutex_;
+    mutable std::condition_variable finished_;
+    SearchResult result_;
+    std::exception_ptr error_;
+};
+
 /// Top-level chess engine API.
 class Engine {
    public:
     explicit Engine(std::size_t tt_mb = 64);
 
-    /// Run search and return the result.
+    /// Engine whose transposition table is shared with other engines.
+    explicit Engine(std::shared_ptr<TranspositionTable> tt);
+
+    /// Stops a running asynchronous search and joins the search thread.
+    ~Engine();
+
+    Engine(const Engine&) = delete;
+    Engine& operator=(const Engine&) = delete;
+
+    /// Run search and return the result. A running asynchronous search is
+    /// stopped and joined first.
     SearchResult search(Position& pos, const SearchLimits& limits);
 
+    /// Start searching a copy of `pos` on the engine's search thread and
+    /// return at once. The thread is started by the first call and then
+    /// serves every later one. A search still running from an earlier call
+    /// is stopped and waited for first. `on_done` runs on the search thread
+    /// after the handle reports completion, also when the search failed
+    /// (see `SearchHandle::error`). Every other method except `cancel` stops
+    /// and waits for the search before doing its work.
+    std::shared_ptr<SearchHandle> start_search(const Position& pos, const SearchLimits& limits,
+                                               SearchCallback on_done = {});
+
+    /// Copy of the most recent search's result, including its statistics.
+    /// A running asynchronous search is stopped and waited for first.
+    [[nodiscard]] SearchResult last_result();
+
     /// Cancel a running search (thread-safe).
     void cancel() noexcept;
 
-    /// Resize the transposition table (clears it).
+    /// Keep aged killers and history between searches instead of clearing
+    /// them. Useful when successive searches follow one game.
+    void set_heuristic_aging(bool enabled);
+
+    /// Resize the transposition table, keeping its entries where possible
+    /// (see TranspositionTable::rehash). A shared table is resized for every
+    /// engine using it. Searches on this engine, or on every engine of its
+    /// pool, are stopped first; other engines sharing the table outside a
+    /// pool must be idle.
     void set_tt_size(std::size_t mb);
 
-    /// Clear the transposition table.
+    /// Clear the transposition table, stopping searches like `set_tt_size`.
     void clear_tt();
 
    private:
+    friend class EnginePool;
+
+    /// An asynchronous search waiting for the search thread.
+    struct Job {
+        Position root;
+        SearchLimits limits;
+        SearchCallback on_done;
+        std::shared_ptr<SearchHandle> handle;
+    };
+
+    /// State shared by the engine and its search thread. The thread holds
+    /// its own reference, so a callback may destroy the engine.
+    struct Worker {
+        std::mutex mutex;               ///< Guards the members below and `last_result_`.
+        std::condition_variable wake;   ///< A job was queued, or exit was set.
+        std::condition_variable idle;   ///< A job and its callback finished.
+        std::optional<Job> job;         ///< Queued search, not yet taken.
+        std::shared_ptr<SearchHandle> active;  ///< Queued or running search.
+        bool busy = false;              ///< Running a job or its callback.
+        bool exit = false;              ///< Set by the engine's destructor.
+        std::thread thread;             ///< Started by the first start_search.
+    };
+
+    /// Body of the search thread.
+    static void worker_loop(Engine* engine, std::shared_ptr<Worker> worker);
+
+    /// Run a search on the calling thread, holding `search_mutex_`.
+    SearchResult run_search(Position& pos, const SearchLimits& limits);
+
+    /// With `lock` held on the worker mutex: stop the queued or running
+    /// search and wait until the search thread is idle. A no-op on the
+    /// search thread itself, where only a finished search's callback runs.
+    void stop_and_wait(std::unique_lock<std::mutex>& lock);
+
+    /// Stop every search on this engine, asynchronous or synchronous on
+    /// another thread, and return a lock that keeps new ones from starting.
+    std::unique_lock<std::mutex> idle();
+
+    /// Stop the running asynchronous search, if any, and wait for it.
+    void join_search();
+
     Search search_;
+    SearchResult last_result_;
+    std::shared_ptr<Worker> worker_ = std::make_shared<Worker>();
+    std::mutex search_mutex_;     ///< Held for the whole of every search
+    EnginePool* pool_ = nullptr;  ///< Owning pool, if any
 };
 
 }  // namespace chessie
@@ -0,0 +1,68 @@
+#pragma once
+
+/// @file engine_pool.hpp
+/// A fixed set of engines sharing one transposition table under a single
+/// memory budget.
+///
+/// Each engine (search context) keeps its own killers, history and
+/// search thread, but all of them probe and store into the same lock-free
+/// table. Play and analysis then reuse each other's work, and the table
+/// is allocated once instead of once per engine.
+
+#include <chessie/engine.hpp>
+
+#include <cstddef>
+#include <memory>
+#include <mutex>
+#include <vector>
+
+namespace chessie {
+
+class EnginePool {
+   public:
+    /// `budget_mb` covers the shared table and every context's own state:
+    /// the engine object plus a fixed reserve (1 MB, more with tracing) for
+    /// its heap and the used part of its thread stacks. The reserve bounds
+    /// a normal search; virtual stack reservations are not counted.
+    /// Throws std::invalid_argument if `contexts` is 0 or the budget cannot
+    /// hold the contexts plus a 1 MB table.
+    EnginePool(std::size_t budget_mb, std::size_t contexts);
+
+    EnginePool(const EnginePool&) = delete;
+    EnginePool& operator=(const EnginePool&) = delete;
+
+    /// Number of search contexts.
+    [[nodiscard]] std::size_t size() const noexcept { return engines_.size(); }
+
+    /// Search context `i`. Throws std::out_of_range.
+    [[nodiscard]] Engine& engine(std::size_t i);
+
+    /// The shared transposition table.
+    [[nodiscard]] TranspositionTable& tt() noexcept { return *tt_; }
+
+    [[nodiscard]] std::size_t budget_mb() const noexcept { return budget_mb_; }
+
+    /// Bytes charged to the table and the contexts, reserves included;
+    /// never above the budget.
+    [[nodiscard]] std::size_t memory_bytes() const noexcept;
+
+    /// Change the budget, rehashing the shared table into its new size.
+    /// Searches on every context are stopped and joined first.
+    void set_budget(std::size_t mb);
+
+    /// Clear the shared table, stopping searches like `set_budget`.
+    void clear_tt();
+
+   private:
+    friend class Engine;
+
+    /// Stop every context's searches and hold them off until the locks are
+    /// released.
+    std::vector<std::unique_lock<std::mutex>> idle_all();
+
+    std::size_t budget_mb_ = 0;
+    std::shared_ptr<TranspositionTable> tt_;
+    std::vector<std::unique_ptr<Engine>> engines_;
+};
+
+}  // namespace chessie
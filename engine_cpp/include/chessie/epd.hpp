@@ -0,0 +1,82 @@
+#pragma once
+
+/// @file epd.hpp
+/// EPD test suites: record parsing and a multi-threaded best-move runner.
+///
+/// An EPD record is the first four FEN fields followed by `;`-terminated
+/// operations, e.g.
+///   r1b1k2r/... w kq - bm Nxe5; am Qxd2; id "WAC.001";
+/// `bm` / `am` operands are SAN (UCI is accepted too); `hmvc` / `fmvn` set
+/// the clocks. A position counts as solved when the engine's move is one
+/// of the `bm` moves (any move, if there are none) and none of the `am`
+/// moves.
+///
+/// Requires magic::init() to have been called first.
+
+#include <chessie/engine.hpp>
+
+#include <cstdint>
+#include <functional>
+#include <iosfwd>
+#include <string>
+#include <string_view>
+#include <utility>
+#include <vector>
+
+namespace chessie::epd {
+
+// ── Records ─────────────────────────────────────────────────────────────────
+
+/// One parsed EPD line.
+struct Record {
+    std::string fen;  ///< Full FEN; clocks from the line, hmvc/fmvn or "0 1".
+    std::string id;
+    std::vector<Move> best_moves;   ///< bm
+    std::vector<Move> avoid_moves;  ///< am
+    /// Every operation in order as (opcode, operand text), quotes removed.
+    std::vector<std::pair<std::string, std::string>> operations;
+
+    /// Does playing `m` solve this record?
+    [[nodiscard]] bool is_solution(Move m) const;
+};
+
+/// Parse one EPD line (a plain FEN line is accepted as well).
+/// Throws std::invalid_argument on a malformed position or move operand.
+[[nodiscard]] Record parse_line(std::string_view line);
+
+/// Parse every non-empty, non-comment ('#') line.
+[[nodiscard]] std::vector<Record> read(std::istream& in);
+
+// ── Suite runner ────────────────────────────────────────────────────────────
+
+struct RunConfig {
+    SearchLimits limits{};  ///< Per-position depth, node and time limits.
+    int threads = 1;
+    std::size_t tt_mb = 16;
+};
+
+/// Outcome of one record.
+struct PositionResult {
+    std::size_t index = 0;  ///< Position in the suite.
+    Move move{};            ///< The engine's final choice.
+    int depth = 0;
+    std::uint64_t nodes = 0;
+    std::int64_t time_ms = 0;
+    bool solved = false;
+    /// First iteration from which every later iteration chose a solution;
+    /// only meaningful when `solved`.
+    int solution_depth = 0;
+    std::int64_t time_to_solution_ms = 0;
+    std::uint64_t nodes_to_solution = 0;
+};
+
+/// Called as each position finishes, serialised across workers.
+using ResultCallback = std::function<void(const Record&, const PositionResult&)>;
+
+/// Search every record, each worker thread with its own engine. Results
+/// are returned in suite order.
+[[nodiscard]] std::vector<PositionResult> run_suite(const std::vector<Record>& records,
+                                                    const RunConfig& config,
+                                                    const ResultCallback& on_result = {});
+
+}  // namespace chessie::epd
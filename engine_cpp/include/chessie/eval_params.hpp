@@ -0,0 +1,114 @@
+#pragma once
+
+/// @file eval_params.hpp
+/// Runtime-loadable evaluation parameters.
+///
+/// Every tunable evaluation weight is a tapered (middlegame, endgame) pair
+/// stored in one flat array, so the tuner can treat the whole evaluation as
+/// a parameter vector. Parameters round-trip through a plain-text format and
+/// can be exported back into the constexpr tables of `evaluation.cpp`.
+
+#include <chessie/types.hpp>
+
+#include <array>
+#include <cstdint>
+#include <iosfwd>
+#include <string>
+#include <string_view>
+
+namespace chessie::eval {
+
+/// A middlegame / endgame weight pair (centipawns), tapered by game phase.
+struct Score {
+    int mg = 0;
+    int eg = 0;
+
+    [[nodiscard]] constexpr bool operator==(const Score&) const noexcept = default;
+};
+
+/// Full set of tunable evaluation weights.
+///
+/// Terms are laid out as consecutive blocks; use the accessors rather than
+/// raw offsets outside of the tuner.
+struct Params {
+    /// Mobility table sizes (safe-square counts 0..max) for Knight..Queen.
+    static constexpr int kMobilitySize[] = {9, 14, 15, 28};
+    /// King attack units are capped at kKingAttackSize - 1.
+    static constexpr int kKingAttackSize = 32;
+
+    static constexpr int kPieceValueOffset = 0;
+    static constexpr int kPstOffset = kPieceValueOffset + kNumPieceTypes;
+    static constexpr int kMobilityOffset = kPstOffset + kNumPieceTypes * 64;
+    static constexpr int kKingAttackOffset =
+        kMobilityOffset + kMobilitySize[0] + kMobilitySize[1] + kMobilitySize[2] + kMobilitySize[3];
+    static constexpr int kNumTerms = kKingAttackOffset + kKingAttackSize;
+
+    std::array<Score, kNumTerms> terms{};
+
+    /// Material value of a piece type (index Pawn=0 .. King=5).
+    [[nodiscard]] constexpr Score& piece_value(int pi) noexcept {
+        return terms[kPieceValueOffset + pi];
+    }
+    [[nodiscard]] constexpr const Score& piece_value(int pi) const noexcept {
+        return terms[kPieceValueOffset + pi];
+    }
+
+    /// Piece-square bonus from WHITE's perspective (a1=0..h8=63).
+    [[nodiscard]] constexpr Score& pst(int pi, int sq) noexcept {
+        return terms[kPstOffset + pi * 64 + sq];
+    }
+    [[nodiscard]] constexpr const Score& pst(int pi, int sq) const noexcept {
+        return terms[kPstOffset + pi * 64 + sq];
+    }
+
+    /// Mobility bonus of a Knight (pi=1) .. Queen (pi=4) with `count` safe squares.
+    [[nodiscard]] constexpr Score& mobility(int pi, int count) noexcept {
+        return terms[mobility_index(pi, count)];
+    }
+    [[nodiscard]] constexpr const Score& mobility(int pi, int count) const noexcept {
+        return terms[mobility_index(pi, count)];
+    }
+
+    /// King-safety score of the side whose king zone takes `units` attack units.
+    [[nodiscard]] constexpr Score& king_attack(int units) noexcept {
+        return terms[kKingAttackOffset + units];
+    }
+    [[nodiscard]] constexpr const Score& king_attack(int units) const noexcept {
+        return terms[kKingAttackOffset + units];
+    }
+
+    /// Term index of mobility(pi, count).
+    [[nodiscard]] static constexpr int mobility_index(int pi, int count) noexcept {
+        int index = kMobilityOffset + count;
+        for (int i = 1; i < pi; ++i) index += kMobilitySize[i - 1];
+        return index;
+    }
+
+    [[nodiscard]] constexpr bool operator==(const Params&) const noexcept = default;
+};
+
+// ── Serialization ───────────────────────────────────────────────────────────
+
+/// Stable human-readable name of a term, e.g. "piece_value.knight", "pst.rook.e7",
+/// "mobility.bishop.5" or "king_attack.12".
+[[nodiscard]] std::string term_name(int index);
+
+/// Inverse of term_name(). Returns -1 for unknown names.
+[[nodiscard]] int term_index(std::string_view name);
+
+/// Write parameters as `name mg eg` lines.
+void save_params(std::ostream& out, const Params& params);
+
+/// Read `name mg eg` lines on top of `params`. Blank lines and `#` comments
+/// are ignored; terms that are not mentioned keep their current value.
+/// Throws std::invalid_argument on malformed lines or unknown names.
+void load_params(std::istream& in, Params& params);
+
+/// Load a parameter file on top of `params` (see load_params).
+/// Throws std::runtime_error if the file cannot be opened.
+void load_params_file(const std::string& path, Params& params);
+
+/// Emit the parameters as the constexpr tables used by `evaluation.cpp`.
+void export_cpp(std::ostream& out, const Params& params);
+
+}  // namespace chessie::eval
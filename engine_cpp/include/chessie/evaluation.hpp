@@ -3,18 +3,102 @@
 /// @file evaluation.hpp
 /// Static evaluation using Piece-Square Tables with tapered eval.
 ///
-/// Uses PeSTO-style middlegame/endgame PST and material values
-/// with game-phase tapering between the two scores.
+/// Uses PeSTO-style middlegame/endgame PST and material values plus
+/// mobility and king-safety terms read from an `AttackMap`, with game-phase
+/// tapering between the two scores. The weights live in a
+/// runtime-replaceable `Params` set (see eval_params.hpp).
 
+#include <chessie/attacks.hpp>
+#include <chessie/eval_params.hpp>
 #include <chessie/position.hpp>
 
+#include <cstdint>
+#include <memory>
+#include <vector>
+
 namespace chessie::eval {
 
+/// Phase contribution per piece type (Pawn=0 .. King=5); total phase = 24.
+inline constexpr int kPhaseWeight[] = {0, 1, 1, 2, 4, 0};
+inline constexpr int kTotalPhase = 24;
+
 /// Evaluate the position from the side-to-move's perspective.
 /// Returns centipawns. Positive = side-to-move is better.
+///
+/// Takes a params() snapshot per call. Code that evaluates many positions
+/// should take one snapshot and pass it to the overload below.
 [[nodiscard]] int evaluate(const Position& pos);
 
+/// Evaluate with an explicit parameter set instead of the active one.
+[[nodiscard]] int evaluate(const Position& pos, const Params& params);
+
+/// Attack-dependent terms (mobility, king safety) of the white-perspective
+/// score, before tapering. Used by the batch evaluator.
+[[nodiscard]] Score attack_score(const PieceBitboards& pieces, const AttackMap& attacks,
+                                 const Params& params);
+
 /// Material-only evaluation (no PST, no tapering). Useful for tests.
 [[nodiscard]] int material(const Position& pos);
 
+// ── Lazy evaluation ─────────────────────────────────────────────────────────
+
+/// Bound on how far the attack-dependent terms (mobility, king safety) move
+/// the material + PST score in practice. Lazy evaluation trusts it.
+inline constexpr int kLazyMargin = 400;
+
+/// How often each tier of the lazy evaluation was enough.
+struct EvalStats {
+    std::uint64_t lazy = 0;  ///< Decided by material + PST alone.
+    std::uint64_t full = 0;  ///< Needed the attack map and attack terms.
+};
+
+/// Window-aware evaluation of the side to move.
+///
+/// Computes material + PST first and returns it as soon as it lies at least
+/// `kLazyMargin` outside (alpha, beta); only positions near the window pay
+/// for the attack map. Inside the window the result equals evaluate(pos).
+[[nodiscard]] int evaluate(const Position& pos, int alpha, int beta, EvalStats* stats = nullptr);
+
+/// Window-aware evaluation with an explicit parameter set.
+[[nodiscard]] int evaluate(const Position& pos, const Params& params, int alpha, int beta,
+                           EvalStats* stats = nullptr);
+
+// ── Parameters ──────────────────────────────────────────────────────────────
+
+/// The compiled-in parameter set.
+[[nodiscard]] const Params& default_params() noexcept;
+
+/// The parameter set used by evaluate(pos). The snapshot stays valid, and
+/// unchanged, after a later set_params(). Taking one locks a mutex, so
+/// searches and batches take it once up front.
+[[nodiscard]] std::shared_ptr<const Params> params();
+
+/// Replace the active parameter set. Safe while searches run: each search
+/// evaluates with the set that was active when it started.
+void set_params(const Params& params);
+
+// ── Tuning trace ────────────────────────────────────────────────────────────
+
+/// Coefficient of one term in a linear evaluation trace.
+struct TraceTerm {
+    std::uint16_t index;
+    std::int16_t coef;
+};
+
+/// Linear decomposition of the evaluation of one position.
+///
+/// The white-perspective tapered score equals
+/// `(Σ coef·term.mg · phase + Σ coef·term.eg · (kTotalPhase − phase)) / kTotalPhase`
+/// up to integer rounding, which is what the tuner differentiates.
+struct Trace {
+    int phase = 0;
+    std::vector<TraceTerm> terms;  ///< Non-zero coefficients, unique indices.
+};
+
+/// Fill `out` with the evaluation trace of `pos` (white perspective).
+void trace(const Position& pos, Trace& out);
+
+/// Trace with an explicit parameter set instead of the active one.
+void trace(const Position& pos, const Params& params, Trace& out);
+
 }  // namespace chessie::eval
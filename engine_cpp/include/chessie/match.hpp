@@ -0,0 +1,140 @@
+#pragma once
+
+/// @file match.hpp
+/// Engine-vs-engine matches: game play, adjudication, PGN output and SPRT.
+///
+/// Two `EngineConfig`s play game pairs from a list of opening positions,
+/// each opening once with either colour. Games run concurrently, one pair
+/// of `Engine`s per worker thread. A sequential probability ratio test on
+/// Elo bounds can end the match early once the result is statistically
+/// clear.
+///
+/// Requires magic::init() to have been called first.
+
+#include <chessie/engine.hpp>
+
+#include <cstdint>
+#include <functional>
+#include <iosfwd>
+#include <optional>
+#include <string>
+#include <string_view>
+#include <vector>
+
+namespace chessie::match {
+
+// ── Configuration ───────────────────────────────────────────────────────────
+
+/// One side of the match.
+struct EngineConfig {
+    std::string name = "chessie";
+    std::size_t tt_mb = 16;
+    SearchLimits limits{};     ///< Per-move depth, node and time limits.
+    std::int64_t base_ms = 0;  ///< Game clock; 0 = no clock (per-move limits only).
+    std::int64_t inc_ms = 0;   ///< Clock increment per move.
+    bool heuristic_aging = true;
+};
+
+/// Sequential probability ratio test on the Elo difference of the first
+/// engine over the second.
+struct SprtConfig {
+    double elo0 = 0.0;  ///< H0: the true difference is elo0.
+    double elo1 = 5.0;  ///< H1: the true difference is elo1.
+    double alpha = 0.05;
+    double beta = 0.05;
+};
+
+struct MatchConfig {
+    EngineConfig first;
+    EngineConfig second;
+    std::vector<std::string> openings;  ///< Start FENs; empty = standard start.
+    int games = 2;                      ///< Upper bound on games played.
+    int concurrency = 1;
+    int max_plies = 400;  ///< Longer games are adjudicated as draws.
+    std::optional<SprtConfig> sprt;
+};
+
+// ── Games ───────────────────────────────────────────────────────────────────
+
+enum class Outcome : std::uint8_t { WhiteWins, BlackWins, Draw };
+
+/// A finished game.
+struct GameRecord {
+    int round = 0;  ///< 1-based game number.
+    std::string white;
+    std::string black;
+    std::string start_fen;
+    std::vector<std::string> san;  ///< Moves in SAN.
+    Outcome outcome = Outcome::Draw;
+    std::string termination;  ///< e.g. "checkmate", "threefold repetition".
+    bool first_is_white = true;
+};
+
+/// "1-0", "0-1" or "1/2-1/2".
+[[nodiscard]] std::string_view result_string(Outcome outcome) noexcept;
+
+/// Play one game from `start_fen` between `white` and `black`, clearing
+/// both engines' transposition tables first.
+[[nodiscard]] GameRecord play_game(Engine& white, const EngineConfig& white_config,
+                                   Engine& black, const EngineConfig& black_config,
+                                   std::string_view start_fen, int max_plies);
+
+/// PGN text of one game, movetext wrapped at 80 columns.
+[[nodiscard]] std::string to_pgn(const GameRecord& game);
+
+// ── Openings ────────────────────────────────────────────────────────────────
+
+/// Read opening positions, one per game pair.
+///
+/// EPD/FEN lines yield their position directly (EPD operations are
+/// ignored). PGN games are replayed from their `[FEN]` tag, or the
+/// standard start, and yield the final position. Throws
+/// std::invalid_argument on a malformed line or illegal move.
+[[nodiscard]] std::vector<std::string> read_openings(std::istream& in);
+
+// ── Statistics ──────────────────────────────────────────────────────────────
+
+/// Results from the first engine's point of view.
+struct Tally {
+    int wins = 0;
+    int draws = 0;
+    int losses = 0;
+
+    [[nodiscard]] int games() const noexcept { return wins + draws + losses; }
+    [[nodiscard]] double score() const noexcept;
+};
+
+enum class SprtDecision : std::uint8_t { Continue, AcceptH0, AcceptH1 };
+
+/// Expected score for an Elo difference (logistic model).
+[[nodiscard]] double expected_score(double elo) noexcept;
+
+/// Elo difference for an expected score in (0, 1).
+[[nodiscard]] double elo_from_score(double score) noexcept;
+
+/// Half-width of the 95% confidence interval of the Elo estimate.
+[[nodiscard]] double elo_error_95(const Tally& tally) noexcept;
+
+/// Log-likelihood ratio of H1 against H0 under the trinomial (W/D/L)
+/// normal approximation. 0 while the sample has no variance.
+[[nodiscard]] double sprt_llr(const Tally& tally, double elo0, double elo1) noexcept;
+
+[[nodiscard]] SprtDecision sprt_decision(double llr, const SprtConfig& config) noexcept;
+
+// ── Match ───────────────────────────────────────────────────────────────────
+
+struct MatchResult {
+    Tally tally;
+    double llr = 0.0;
+    SprtDecision decision = SprtDecision::Continue;
+};
+
+/// Called after every game, serialised across workers.
+using GameCallback = std::function<void(const GameRecord&, const Tally&)>;
+
+/// Play the match. Stops after `config.games` games or, when SPRT is
+/// configured, as soon as a hypothesis is accepted (games already in
+/// flight are finished and counted).
+[[nodiscard]] MatchResult run_match(const MatchConfig& config, const GameCallback& on_game = {});
+
+}  // namespace chessie::match
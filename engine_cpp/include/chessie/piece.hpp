@@ -5,10 +5,14 @@
 
 #include <chessie/types.hpp>
 
+#include <cstdint>
 #include <string>
 
 namespace chessie {
 
+/// One-byte piece code, `color << 3 | type`. 0 means "no piece".
+using PieceCode = std::uint8_t;
+
 /// An immutable piece on the board (color + type).
 struct Piece {
     Color color;
@@ -16,6 +20,16 @@ struct Piece {
 
     [[nodiscard]] constexpr bool operator==(const Piece&) const noexcept = default;
 
+    /// Packed one-byte form of this piece.
+    [[nodiscard]] constexpr PieceCode code() const noexcept {
+        return static_cast<PieceCode>(color_index(color) << 3 | static_cast<int>(type));
+    }
+
+    /// Unpack a code produced by `code()`.
+    [[nodiscard]] static constexpr Piece from_code(PieceCode code) noexcept {
+        return {static_cast<Color>(code >> 3), static_cast<PieceType>(code & 7)};
+    }
+
     /// FEN character for this piece ('P','N','B','R','Q','K' for white, lowercase for black).
     [[nodiscard]] constexpr char fen_char() const noexcept {
         // clang-format off
@@ -32,6 +32,8 @@ struct UndoInfo {
     int halfmove_clock;
     Piece captured;     ///< kNoPiece if no capture
     std::uint64_t key;  ///< Zobrist key before the move
+    Bitboard checkers;  ///< Check state before the move
+    Bitboard blockers_for_king[2];
 };
 
 // ── Castling rights update table ────────────────────────────────────────────
@@ -73,12 +75,26 @@ inline constexpr auto kCastleMask = make_castling_masks();
 
 }  // namespace detail
 
+// ── Check info ──────────────────────────────────────────────────────────────
+
+/// What the side to move needs to tell whether a move gives check. Computed
+/// once per node with `Position::check_info()`.
+struct CheckInfo {
+    Square enemy_king = kNoSquare;
+    /// Squares from which a piece of each type attacks the enemy king,
+    /// indexed by piece_index().
+    Bitboard check_squares[kNumPieceTypes]{};
+    /// Our pieces that are the only blocker between the enemy king and one
+    /// of our sliders; moving one off that line discovers check.
+    Bitboard discoverers = kEmptyBB;
+};
+
 // ── Position ────────────────────────────────────────────────────────────────
 
 class Position {
    public:
     /// Construct from explicit fields. Computes Zobrist hash.
-    Position(Board board, Color side, CastlingRights castling, Square ep, int halfmove,
+    Position(const Board& board, Color side, CastlingRights castling, Square ep, int halfmove,
              int fullmove);
 
     /// Default: empty board, white to move, no castling, no EP.
@@ -128,19 +144,62 @@ class Position {
     /// Is `sq` attacked by any piece of color `by`?
     [[nodiscard]] bool is_square_attacked(Square sq, Color by) const noexcept;
 
-    /// Is the side-to-move's king in check?
-    [[nodiscard]] bool is_in_check() const noexcept;
+    /// Is the side-to-move's king in check? A load of the cached checkers.
+    [[nodiscard]] bool is_in_check() const noexcept { return checkers_ != kEmptyBB; }
 
     /// Is the specified color's king in check?
     [[nodiscard]] bool is_in_check(Color c) const noexcept;
 
+    /// Enemy pieces giving check to the side to move.
+    [[nodiscard]] Bitboard checkers() const noexcept { return checkers_; }
+
+    /// Pieces of either colour that alone shield `c`'s king from an enemy
+    /// slider.
+    [[nodiscard]] Bitboard blockers_for_king(Color c) const noexcept {
+        return blockers_for_king_[color_index(c)];
+    }
+
+    /// Side-to-move pieces pinned to their own king.
+    [[nodiscard]] Bitboard pinned() const noexcept {
+        return blockers_for_king(side_to_move_) & board_.occupied(side_to_move_);
+    }
+
+    /// Pieces of either colour attacking `sq` given occupancy `occ`.
+    [[nodiscard]] Bitboard attackers_to(Square sq, Bitboard occ) const noexcept;
+
+    // ── Move validation ─────────────────────────────────────────────────
+    // Both accept arbitrary moves, e.g. from a TT entry that belongs to
+    // another position, and never modify the position.
+
+    /// Could `m` have come from movegen::pseudo_legal() in this position?
+    [[nodiscard]] bool is_pseudo_legal(Move m) const noexcept;
+
+    /// Does the pseudo-legal move `m` leave the mover's king safe?
+    [[nodiscard]] bool is_legal(Move m) const noexcept;
+
+    /// Check squares and discovered-check candidates of the side to move.
+    [[nodiscard]] CheckInfo check_info() const noexcept;
+
+    /// Does the pseudo-legal move `m` of the side to move give check? Decided
+    /// without making the move.
+    [[nodiscard]] bool gives_check(Move m, const CheckInfo& ci) const noexcept;
+
+    [[nodiscard]] bool gives_check(Move m) const noexcept { return gives_check(m, check_info()); }
+
     // ── Repetition ──────────────────────────────────────────────────────
 
     /// How many times the current position key has occurred (including current).
     [[nodiscard]] int repetition_count() const;
 
+    // ── Draw rules ──────────────────────────────────────────────────────
+
+    /// Neither side can possibly mate: K v K, K+minor v K, or K+B v K+B
+    /// with both bishops on the same square colour.
+    [[nodiscard]] bool is_insufficient_material() const noexcept;
+
    private:
     void compute_key();
+    void update_check_state() noexcept;
     void toggle_piece_hash(Piece p, Square sq);
     void toggle_side_hash();
     void set_castling(CastlingRights cr);
@@ -153,6 +212,11 @@ class Position {
     int halfmove_clock_ = 0;
     int fullmove_number_ = 1;
     std::uint64_t key_ = 0;
+    // Check state of the side to move and of both kings' shields, refreshed
+    // by make_move and restored by unmake_move. Direct edits through board()
+    // do not update it.
+    Bitboard checkers_ = kEmptyBB;
+    Bitboard blockers_for_king_[2]{};
     std::vector<UndoInfo> history_;
     std::vector<std::uint64_t> key_history_;  ///< All keys since game start (for repetition)
 };
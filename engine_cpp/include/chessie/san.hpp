@@ -0,0 +1,26 @@
+#pragma once
+
+/// @file san.hpp
+/// Standard Algebraic Notation (SAN) formatting and parsing.
+///
+/// Requires magic::init() to have been called first.
+
+#include <chessie/move.hpp>
+#include <chessie/position.hpp>
+
+#include <string>
+#include <string_view>
+
+namespace chessie::san {
+
+/// SAN of the legal move `m` in `pos`, with "+" / "#" suffixes, e.g. "Nbd7",
+/// "exd6", "O-O", "e8=Q#". `pos` is restored before returning.
+[[nodiscard]] std::string format(Position& pos, Move m);
+
+/// Parse a SAN move in `pos`. Accepts check/annotation suffixes ("+", "#",
+/// "!", "?"), "0-0" castling and promotions with or without "=".
+/// Throws std::invalid_argument if no legal move matches or the text is
+/// ambiguous.
+[[nodiscard]] Move parse(Position& pos, std::string_view text);
+
+}  // namespace chessie::san
@@ -10,7 +10,17 @@
 
 #include <atomic>
 #include <chrono>
+#include <condition_variable>
 #include <cstdint>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+/// Search statistics counters; set by the SEARCH_STATS CMake option.
+#ifndef CHESSIE_SEARCH_STATS
+#define CHESSIE_SEARCH_STATS 0
+#endif
 
 namespace chessie {
 
@@ -20,11 +30,127 @@ inline constexpr int kInfScore = 1'000'000;
 inline constexpr int kMateScore = 100'000;
 inline constexpr int kMaxPly = 128;
 
+/// Mate score in the transposition table's 16-bit score field.
+inline constexpr int kTTMateScore = 32'000;
+
+/// Score as stored in the transposition table by a node at `ply`. A mate
+/// is stored as its distance from this node rather than from the root, so
+/// it stays right when the position recurs at another ply. Other scores are
+/// clamped below the mate range.
+[[nodiscard]] constexpr int score_to_tt(int score, int ply) noexcept {
+    if (score > kMateScore - kMaxPly)
+        return score - (kMateScore - kTTMateScore) + ply;
+    if (score < -kMateScore + kMaxPly)
+        return score + (kMateScore - kTTMateScore) - ply;
+    return score > kTTMateScore - kMaxPly    ? kTTMateScore - kMaxPly
+           : score < -kTTMateScore + kMaxPly ? -kTTMateScore + kMaxPly
+                                             : score;
+}
+
+/// Inverse of `score_to_tt` for a node at `ply`.
+[[nodiscard]] constexpr int score_from_tt(int score, int ply) noexcept {
+    if (score > kTTMateScore - kMaxPly)
+        return score + (kMateScore - kTTMateScore) - ply;
+    if (score < -kTTMateScore + kMaxPly)
+        return score - (kMateScore - kTTMateScore) + ply;
+    return score;
+}
+
+/// Whether the search collects `SearchStats` counters. When false every
+/// counter update compiles away and the counters stay zero.
+inline constexpr bool kSearchStats = CHESSIE_SEARCH_STATS != 0;
+
 // ── Search limits ───────────────────────────────────────────────────────────
 
 struct SearchLimits {
     int max_depth = 64;
     std::int64_t time_limit_ms = -1;  ///< -1 = no time limit.
+    std::uint64_t max_nodes = 0;      ///< 0 = no node limit.
+    /// Optional external stop signal, polled like `Search::cancel()` but
+    /// never reset by the search. Must outlive the search.
+    const std::atomic<bool>* stop_flag = nullptr;
+};
+
+// ── Heuristic reuse ─────────────────────────────────────────────────────────
+
+/// How move-ordering heuristics carry over from one search to the next.
+enum class HeuristicReuse : std::uint8_t {
+    Clear,  ///< Reset killers and history before every search.
+    Age,    ///< Halve history and shift killers by the plies played since the
+            ///< previous search's root (cleared if the root moved backwards).
+};
+
+// ── Search statistics ───────────────────────────────────────────────────────
+
+/// One completed iterative-deepening iteration.
+struct IterationStats {
+    int depth = 0;
+    Move best_move{};  ///< Root move chosen by this iteration.
+    int score = 0;
+    int seldepth = 0;          ///< Deepest ply reached so far, quiescence included.
+    std::uint64_t nodes = 0;   ///< Nodes searched by this iteration alone.
+    double ebf = 0.0;          ///< nodes / previous iteration's nodes (0 for the first).
+    std::int64_t time_ms = 0;  ///< Elapsed since the search started.
+    std::uint64_t nps = 0;     ///< Total nodes per second so far.
+    int hashfull = 0;          ///< TT fill in per-mille at the end of the iteration.
+    /// Share of all nodes so far spent under the best root move. A low share
+    /// means the choice is still contested.
+    double best_move_node_fraction = 0.0;
+};
+
+/// Per-search counters describing the shape of the tree.
+///
+/// All counters except `iterations` are only collected when `kSearchStats`
+/// is true; otherwise they stay zero.
+struct SearchStats {
+    std::uint64_t qnodes = 0;  ///< Quiescence nodes (included in the total).
+    std::uint64_t tt_probes = 0;
+    std::uint64_t tt_hits = 0;
+    std::uint64_t tt_cutoffs = 0;  ///< Nodes answered from the TT bound.
+    std::uint64_t null_tries = 0;
+    std::uint64_t null_cutoffs = 0;
+    std::uint64_t lmr_researches = 0;   ///< Reduced searches that failed high.
+    std::uint64_t futility_prunes = 0;  ///< Quiet moves skipped near the horizon.
+    std::uint64_t reverse_futility_prunes = 0;
+    std::uint64_t razor_prunes = 0;    ///< Low-depth nodes settled by quiescence.
+    std::uint64_t probcut_prunes = 0;  ///< Deep nodes cut by a shallow capture search.
+    std::uint64_t beta_cutoffs = 0;  ///< Fail-highs in the main search move loop.
+    std::uint64_t first_move_cutoffs = 0;
+    eval::EvalStats eval;  ///< Quiescence stand-pat evaluation tiers.
+    std::vector<IterationStats> iterations;
+
+    /// Fraction of beta cutoffs produced by the first move searched.
+    [[nodiscard]] double first_move_cutoff_rate() const noexcept {
+        return beta_cutoffs == 0 ? 0.0
+                                 : static_cast<double>(first_move_cutoffs) /
+                                       static_cast<double>(beta_cutoffs);
+    }
+};
+
+// ── Root moves ──────────────────────────────────────────────────────────────
+
+/// A legal root move with the statistics that order the root between
+/// iterations.
+struct RootMove {
+    explicit RootMove(Move m) : move(m), pv{m} {}
+
+    Move move{};
+    int score = -kInfScore;           ///< Last iteration's score; -kInfScore if it failed low.
+    int previous_score = -kInfScore;  ///< `score` of the iteration before.
+    std::uint64_t nodes = 0;          ///< Subtree nodes summed over all iterations.
+    std::vector<Move> pv;             ///< Principal variation starting with `move`.
+};
+
+// ── Search stack ────────────────────────────────────────────────────────────
+
+/// State of one ply of the line being searched. `Search` keeps an entry per
+/// ply so a node can look back at its ancestors.
+struct SearchStack {
+    static constexpr int kNoEval = -kInfScore;  ///< `static_eval` of a node in check.
+
+    int static_eval = kNoEval;
+    Move current_move{};  ///< Move being searched from this ply; null for a null move.
+    Move killers[2]{};    ///< Quiet moves that caused a cutoff at this ply.
 };
 
 // ── Search result ───────────────────────────────────────────────────────────
@@ -34,6 +160,20 @@ struct SearchResult {
     int score_cp = 0;
     int depth = 0;
     std::uint64_t nodes = 0;
+    int seldepth = 0;          ///< Deepest ply reached, quiescence included.
+    std::int64_t time_ms = 0;  ///< Wall time of the whole search.
+    std::uint64_t nps = 0;
+    int hashfull = 0;  ///< TT fill in per-mille (0-1000).
+    SearchStats stats{};
+    /// Root moves in the order of the last completed iteration, best first.
+    std::vector<RootMove> root_moves;
+
+    /// Share of all nodes spent under the best root move.
+    [[nodiscard]] double best_move_node_fraction() const noexcept {
+        return root_moves.empty() || nodes == 0 ? 0.0
+                                                : static_cast<double>(root_moves.front().nodes) /
+                                                      static_cast<double>(nodes);
+    }
 };
 
 // ── Search class ────────────────────────────────────────────────────────────
@@ -42,18 +182,41 @@ class Search {
    public:
     explicit Search(std::size_t tt_mb = 64);
 
+    /// Search with a transposition table shared with other searches.
+    explicit Search(std::shared_ptr<TranspositionTable> tt);
+
+    /// Stops the watchdog thread.
+    ~Search();
+
+    Search(const Search&) = delete;
+    Search& operator=(const Search&) = delete;
+
     /// Run iterative-deepening search. Returns the best move and score.
     SearchResult search(Position& pos, const SearchLimits& limits);
 
     /// Cancel the search from another thread (or same thread via callback).
     void cancel() noexcept { cancelled_.store(true, std::memory_order_relaxed); }
 
+    /// Choose how killers and history survive between searches. Aging pays
+    /// off when consecutive searches are a ply or two apart in one game.
+    void set_heuristic_reuse(HeuristicReuse mode) noexcept { heuristic_reuse_ = mode; }
+    [[nodiscard]] HeuristicReuse heuristic_reuse() const noexcept { return heuristic_reuse_; }
+
     /// Access the TT for resizing, etc.
-    TranspositionTable& tt() noexcept { return tt_; }
+    TranspositionTable& tt() noexcept { return *tt_; }
+
+    /// Counters of the last search.
+    [[nodiscard]] const SearchStats& stats() const noexcept { return stats_; }
+
+    /// Lazy-evaluation tier counts of the last search (quiescence stand-pat).
+    [[nodiscard]] const eval::EvalStats& eval_stats() const noexcept { return stats_.eval; }
 
    private:
+    friend struct SearchTestAccess;  // White-box heuristic tests
+
     // ── Core search routines ────────────────────────────────────────────
     int negamax(Position& pos, int depth, int alpha, int beta, int ply, bool allow_null);
+    [[nodiscard]] bool is_improving(int ply) const noexcept;
     int quiescence(Position& pos, int alpha, int beta, int ply, int q_depth);
 
     // ── Move ordering ───────────────────────────────────────────────────
@@ -61,32 +224,72 @@ class Search {
     int move_score(const Position& pos, Move m, Move tt_move, int ply) const;
 
     // ── Helpers ─────────────────────────────────────────────────────────
+    [[nodiscard]] std::int64_t elapsed_us() const;
+    [[nodiscard]] IterationStats iteration_stats(int depth, std::uint64_t iter_nodes,
+                                                 double ebf) const;
+    [[nodiscard]] SearchResult make_result(Move best_move, int score, int depth) const;
     [[nodiscard]] bool should_stop() const;
+    void sort_root_moves();
+    void extract_pv(Position& pos, RootMove& rm);
     [[nodiscard]] bool is_draw(const Position& pos) const;
     [[nodiscard]] bool has_non_pawn_material(const Position& pos, Color side) const;
 
     void record_killer(Move m, int ply);
     void update_history(Color side, Move m, int depth);
     void reset_heuristics();
+    void age_heuristics(int plies);
+    void prepare_heuristics(const Position& root);
+
+    /// Increment one `SearchStats` counter; a no-op unless `kSearchStats`.
+    void count(std::uint64_t SearchStats::*counter) noexcept {
+        if constexpr (kSearchStats)
+            ++(stats_.*counter);
+    }
+
+    // ── Watchdog ────────────────────────────────────────────────────────
+    // Started on the first search with a deadline or stop flag, then parked
+    // between searches. Raises cancelled_ when the deadline passes or the
+    // external stop flag is set.
+    void arm_watchdog();
+    void disarm_watchdog();
+    void watchdog_loop();
 
     // ── Data members ────────────────────────────────────────────────────
-    TranspositionTable tt_;
+    std::shared_ptr<TranspositionTable> tt_;
+    std::shared_ptr<const eval::Params> params_;  ///< Eval parameters, fixed per search.
+
+    // Per-ply state of the current line, killers included
+    SearchStack stack_[kMaxPly]{};
 
-    // Killer moves: 2 per ply
-    Move killers_[kMaxPly][2]{};
+    std::vector<RootMove> root_moves_;
 
     // History heuristic: [color][from][to]
     int history_[2][64][64]{};
 
+    HeuristicReuse heuristic_reuse_ = HeuristicReuse::Clear;
+    int last_root_ply_ = -1;  ///< Game ply of the previous search's root.
+
     // Cancellation
     std::atomic<bool> cancelled_{false};
 
-    // Time management
+    // Time management; the deadline and stop flag are read by the watchdog
+    // under watchdog_mutex_.
+    std::chrono::steady_clock::time_point start_{};
     std::chrono::steady_clock::time_point deadline_{};
     bool has_deadline_ = false;
+    std::uint64_t node_limit_ = ~std::uint64_t{0};  ///< max_nodes, or "unlimited".
+    const std::atomic<bool>* stop_flag_ = nullptr;
+
+    std::thread watchdog_;
+    std::mutex watchdog_mutex_;
+    std::condition_variable watchdog_cv_;
+    bool watchdog_armed_ = false;
+    bool watchdog_exit_ = false;
 
     // Stats
     std::uint64_t nodes_ = 0;
+    int seldepth_ = 0;
+    SearchStats stats_;
 };
 
 }  // namespace chessie
@@ -0,0 +1,119 @@
+#pragma once
+
+/// @file trace.hpp
+/// Scoped timing spans exported as Chrome trace JSON.
+///
+/// Each thread records completed spans into its own fixed-size ring buffer
+/// (single writer, no locks on the record path; the oldest spans are
+/// overwritten once it is full). A buffer passes to a later thread once its
+/// owner exits, so short-lived threads do not pile up buffers; the `tid` of
+/// an exported span names the buffer. `dump_json()` merges all buffers into
+/// the Chrome trace-event format, viewable in chrome://tracing or Perfetto.
+///
+/// The `CHESSIE_TRACE_SCOPE` macros compile to nothing unless the engine is
+/// built with the CHESSIE_TRACE CMake option, so instrumented hot paths cost
+/// nothing in normal builds. The recorder itself is always available.
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <limits>
+#include <string>
+#include <string_view>
+
+#ifndef CHESSIE_TRACE
+#define CHESSIE_TRACE 0
+#endif
+
+namespace chessie::trace {
+
+/// Whether the engine's built-in spans are compiled in.
+inline constexpr bool kEnabled = CHESSIE_TRACE != 0;
+
+/// Spans kept per thread before the oldest are overwritten.
+inline constexpr std::size_t kRingCapacity = std::size_t{1} << 16;
+
+/// Value of `Event::arg` when the span carries no argument.
+inline constexpr std::int64_t kNoArg = std::numeric_limits<std::int64_t>::min();
+
+// ── Events ──────────────────────────────────────────────────────────────────
+
+/// One completed span.
+struct Event {
+    const char* name = nullptr;  ///< Must point to a string literal.
+    std::uint64_t begin_ns = 0;  ///< Nanoseconds since the trace epoch.
+    std::uint64_t end_ns = 0;
+    std::int64_t arg = kNoArg;
+    std::array<char, 8> detail{};  ///< Short NUL-terminated label (e.g. a move).
+};
+
+/// Nanoseconds since the trace epoch (first use of the recorder).
+[[nodiscard]] std::uint64_t now_ns() noexcept;
+
+/// Append a completed span to the calling thread's ring buffer.
+void record(const Event& event) noexcept;
+
+/// Drop all recorded spans. Call while no thread is recording.
+void clear() noexcept;
+
+/// Number of spans currently held across all threads.
+[[nodiscard]] std::size_t size() noexcept;
+
+/// All recorded spans as a Chrome trace-event JSON document.
+/// Call while no thread is recording.
+[[nodiscard]] std::string dump_json();
+
+/// Write `dump_json()` to `path`. Returns false if the file cannot be written.
+bool write_json(const std::string& path);
+
+// ── Scoped span ─────────────────────────────────────────────────────────────
+
+/// Records the time between construction and destruction as one span.
+class Span {
+   public:
+    explicit Span(const char* name, std::int64_t arg = kNoArg) noexcept {
+        event_.name = name;
+        event_.arg = arg;
+        event_.begin_ns = now_ns();
+    }
+
+    ~Span() {
+        event_.end_ns = now_ns();
+        record(event_);
+    }
+
+    Span(const Span&) = delete;
+    Span& operator=(const Span&) = delete;
+
+    /// Attach a short label; truncated to 7 characters.
+    void set_detail(std::string_view text) noexcept {
+        const std::size_t n = text.size() < event_.detail.size() ? text.size()
+                                                                 : event_.detail.size() - 1;
+        text.copy(event_.detail.data(), n);
+        event_.detail[n] = '\0';
+    }
+
+   private:
+    Event event_;
+};
+
+}  // namespace chessie::trace
+
+// ── Instrumentation macros ──────────────────────────────────────────────────
+
+#define CHESSIE_TRACE_CONCAT_(a, b) a##b
+#define CHESSIE_TRACE_CONCAT(a, b) CHESSIE_TRACE_CONCAT_(a, b)
+
+#if CHESSIE_TRACE
+/// Time the enclosing scope as a span called `name`.
+#define CHESSIE_TRACE_SCOPE(name) \
+    ::chessie::trace::Span CHESSIE_TRACE_CONCAT(chessie_trace_span_, __LINE__)(name)
+/// Time the enclosing scope as a named span variable `var` with an integer arg.
+#define CHESSIE_TRACE_SPAN(var, name, arg) ::chessie::trace::Span var(name, arg)
+/// Attach a label to a span declared with CHESSIE_TRACE_SPAN.
+#define CHESSIE_TRACE_DETAIL(var, text) var.set_detail(text)
+#else
+#define CHESSIE_TRACE_SCOPE(name) static_cast<void>(0)
+#define CHESSIE_TRACE_SPAN(var, name, arg) static_cast<void>(0)
+#define CHESSIE_TRACE_DETAIL(var, text) static_cast<void>(0)
+#endif
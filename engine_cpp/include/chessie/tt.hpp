@@ -6,12 +6,22 @@
 /// Uses a power-of-2 sized hash table with single-entry buckets.
 /// Replacement policy: always-replace with age preference (newer entries
 /// take priority; among same-age entries, deeper entries are preferred).
+///
+/// The table is safe to share between concurrently searching threads
+/// without locks. Each slot is two 64-bit words, a data word and a check
+/// word holding `meta ^ data`. A slot torn by racing writers decodes to
+/// the wrong key and reads as a miss.
+///
+/// Storage is allocated on first use with calloc, so the OS hands out
+/// zero pages lazily and an engine that never searches costs no memory.
 
 #include <chessie/move.hpp>
 #include <chessie/types.hpp>
 
+#include <atomic>
+#include <cstddef>
 #include <cstdint>
-#include <vector>
+#include <mutex>
 
 namespace chessie {
 
@@ -33,7 +43,7 @@ struct TTEntry {
     std::int16_t score = 0;        ///< Search score (centipawns).
     std::int16_t static_eval = 0;  ///< Static eval at this node (for future pruning).
     Move best_move{};              ///< Best move found (4 bytes).
-    std::uint8_t depth = 0;        ///< Search depth for this entry.
+    std::int8_t depth = 0;         ///< Search depth; quiescence entries use 0 / -1.
     Bound bound = Bound::None;     ///< Type of bound.
     std::uint8_t age = 0;          ///< Search generation (for replacement).
     std::uint8_t padding_ = 0;     ///< Padding to 16 bytes.
@@ -49,16 +59,31 @@ class TranspositionTable {
     static constexpr std::size_t kDefaultSizeMB = 64;
 
     /// Construct with given size in megabytes. Rounds to nearest power of 2 entry count.
+    /// Nothing is allocated until the first search or store.
     explicit TranspositionTable(std::size_t mb = kDefaultSizeMB);
 
+    ~TranspositionTable();
+
+    TranspositionTable(const TranspositionTable&) = delete;
+    TranspositionTable& operator=(const TranspositionTable&) = delete;
+
     /// Resize the table (clears all entries).
     void resize(std::size_t mb);
 
-    /// Clear all entries (zero-fill).
+    /// Resize the table, moving existing entries into the new one. Every
+    /// entry survives a shrink unless two collide (the newer, then deeper,
+    /// one wins). When growing, entries survive while the table stays
+    /// within 1 MB - 256 MB; outside that range the extra index bits are
+    /// not recorded and those entries are dropped. No searches may run.
+    void rehash(std::size_t mb);
+
+    /// Clear all entries, keeping the storage. Safe while other threads
+    /// probe and store.
     void clear();
 
-    /// Increment the age counter. Call at the start of each new search.
-    void new_search() noexcept;
+    /// Increment the age counter and make sure storage is allocated. Call at
+    /// the start of each new search. Throws std::bad_alloc.
+    void new_search();
 
     /// Probe the table for the given Zobrist key.
     /// @param key Full 64-bit Zobrist hash.
@@ -77,16 +102,37 @@ class TranspositionTable {
                int static_eval) noexcept;
 
     /// Number of entries in the table. Useful for tests.
-    [[nodiscard]] std::size_t entry_count() const noexcept { return table_.size(); }
+    [[nodiscard]] std::size_t entry_count() const noexcept { return count_; }
+
+    /// Table size in bytes once allocated.
+    [[nodiscard]] std::size_t size_bytes() const noexcept { return count_ * sizeof(Slot); }
+
+    /// Whether storage has been allocated yet.
+    [[nodiscard]] bool allocated() const noexcept {
+        return table_.load(std::memory_order_acquire) != nullptr;
+    }
 
     /// Current age. Useful for tests.
-    [[nodiscard]] std::uint8_t age() const noexcept { return age_; }
+    [[nodiscard]] std::uint8_t age() const noexcept {
+        return age_.load(std::memory_order_relaxed);
+    }
 
-    /// Approximate fill rate in per-mille (0-1000).
-    /// Samples the first 1000 entries.
+    /// Approximate fill rate in per-mille (0-1000) of entries written by the
+    /// current search. Samples 1000 entries spread evenly over the table.
     [[nodiscard]] int hashfull() const noexcept;
 
    private:
+    /// One lock-free slot; see the file comment.
+    struct Slot {
+        std::atomic<std::uint64_t> check{0};  ///< meta ^ data
+        std::atomic<std::uint64_t> data{0};   ///< score, static eval, best move
+    };
+    static_assert(sizeof(Slot) == 16, "Slot must be 16 bytes for cache efficiency");
+
+    /// Allocate zeroed storage if there is none yet. Returns nullptr on
+    /// allocation failure.
+    Slot* allocate() noexcept;
+
     /// Extract the upper 32 bits as verification key.
     [[nodiscard]] static constexpr std::uint32_t key_upper(std::uint64_t key) noexcept {
         return static_cast<std::uint32_t>(key >> 32);
@@ -97,9 +143,11 @@ class TranspositionTable {
         return static_cast<std::size_t>(key) & mask_;
     }
 
-    std::vector<TTEntry> table_;
-    std::size_t mask_ = 0;  ///< entry_count - 1 (power-of-2 mask)
-    std::uint8_t age_ = 0;  ///< Current search generation
+    std::atomic<Slot*> table_{nullptr};  ///< calloc'd; null until first use
+    std::mutex alloc_mutex_;
+    std::size_t count_ = 0;
+    std::size_t mask_ = 0;              ///< entry_count - 1 (power-of-2 mask)
+    std::atomic<std::uint8_t> age_{0};  ///< Current search generation
 };
 
 }  // namespace chessie
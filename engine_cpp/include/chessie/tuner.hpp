@@ -0,0 +1,124 @@
+#pragma once
+
+/// @file tuner.hpp
+/// Texel-style evaluation tuning over binary position datasets.
+///
+/// Positions are stored as fixed 32-byte records that can be memory-mapped
+/// straight from disk. The tuner decomposes every position into a sparse
+/// linear evaluation trace once, then minimises the mean squared error
+/// between `sigmoid(K · eval)` and the game result with Adam gradient descent,
+/// splitting the dataset across worker threads.
+
+#include <chessie/evaluation.hpp>
+#include <chessie/position.hpp>
+
+#include <cstddef>
+#include <cstdint>
+#include <iosfwd>
+#include <span>
+#include <string>
+#include <vector>
+
+namespace chessie::tune {
+
+// ── Dataset records ─────────────────────────────────────────────────────────
+
+/// Compact position + game-result record (32 bytes, no castling / EP state).
+struct PackedPosition {
+    std::uint64_t occupancy = 0;  ///< Occupied squares.
+    std::uint8_t pieces[16]{};    ///< 4-bit codes (color << 3 | type), LSB-first over occupancy.
+    std::uint8_t side = 0;        ///< 0 = white to move, 1 = black.
+    std::uint8_t result = 1;      ///< White's result: 0 = loss, 1 = draw, 2 = win.
+    std::uint8_t reserved[6]{};
+};
+
+static_assert(sizeof(PackedPosition) == 32, "PackedPosition must be 32 bytes");
+
+/// Pack a position with at most 32 pieces. `white_result` is 0, 0.5 or 1.
+/// Throws std::invalid_argument if the position has more than 32 pieces.
+[[nodiscard]] PackedPosition pack(const Position& pos, double white_result);
+
+/// Rebuild the position (no castling rights, no EP square).
+[[nodiscard]] Position unpack(const PackedPosition& packed);
+
+/// Game result from white's point of view: 0, 0.5 or 1.
+[[nodiscard]] constexpr double white_result(const PackedPosition& packed) noexcept {
+    return packed.result * 0.5;
+}
+
+/// Convert text lines of the form `<FEN> <result>` into binary records.
+///
+/// The result is the last token and may be written as `1-0`, `0-1`,
+/// `1/2-1/2`, `[1.0]`, `[0.5]`, `[0.0]` (quotes and `;` are ignored).
+/// Malformed lines are skipped. Returns the number of records written.
+std::size_t convert_text(std::istream& in, std::ostream& out);
+
+/// Read-only view of a binary dataset file, memory-mapped where supported.
+class Dataset {
+   public:
+    /// Open `path`. With `use_mmap` the file is mapped instead of read.
+    /// Throws std::runtime_error on I/O failure or a truncated file.
+    explicit Dataset(const std::string& path, bool use_mmap = true);
+    ~Dataset();
+
+    Dataset(const Dataset&) = delete;
+    Dataset& operator=(const Dataset&) = delete;
+
+    [[nodiscard]] std::span<const PackedPosition> positions() const noexcept {
+        return {data_, size_};
+    }
+    [[nodiscard]] std::size_t size() const noexcept { return size_; }
+    [[nodiscard]] bool mapped() const noexcept { return mapping_ != nullptr; }
+
+   private:
+    const PackedPosition* data_ = nullptr;
+    std::size_t size_ = 0;
+    void* mapping_ = nullptr;  ///< mmap base when mapped.
+    std::size_t mapping_bytes_ = 0;
+    std::vector<PackedPosition> buffer_;  ///< Storage when read into memory.
+};
+
+// ── Tuner ───────────────────────────────────────────────────────────────────
+
+/// Gradient-descent tuner over all `eval::Params` terms.
+class Tuner {
+   public:
+    /// Trace every position in parallel. `threads` <= 0 uses all hardware threads.
+    Tuner(std::span<const PackedPosition> positions, const eval::Params& initial, int threads = 0);
+
+    /// Mean squared error of the current weights for scaling constant `k`.
+    [[nodiscard]] double error(double k) const;
+
+    /// Scan for the `k` that minimises error() with the current weights.
+    [[nodiscard]] double find_k() const;
+
+    /// One full-batch Adam update. Returns the error before the update.
+    double step(double k, double learning_rate);
+
+    /// Current weights rounded to integers.
+    [[nodiscard]] eval::Params params() const;
+
+    [[nodiscard]] std::size_t size() const noexcept { return entries_.size(); }
+    [[nodiscard]] int threads() const noexcept { return threads_; }
+
+   private:
+    struct Entry {
+        std::uint32_t begin;  ///< First term in terms_.
+        std::uint16_t count;  ///< Number of terms.
+        std::uint8_t phase;
+        float result;  ///< White's result in [0, 1].
+    };
+
+    /// Linear white-perspective evaluation of one entry with current weights.
+    [[nodiscard]] double linear_eval(const Entry& e) const noexcept;
+
+    std::vector<eval::TraceTerm> terms_;
+    std::vector<Entry> entries_;
+    std::vector<double> weights_;  ///< [2 * kNumTerms]: mg at 2i, eg at 2i + 1.
+    std::vector<double> moment1_;
+    std::vector<double> moment2_;
+    int threads_ = 1;
+    int iteration_ = 0;
+};
+
+}  // namespace chessie::tune
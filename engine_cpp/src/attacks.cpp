@@ -0,0 +1,72 @@
+/// @file attacks.cpp
+/// Attack map construction.
+
+#include <chessie/attacks.hpp>
+#include <chessie/magic.hpp>
+
+namespace chessie {
+
+PieceBitboards piece_bitboards(const Board& board) noexcept {
+    PieceBitboards pieces{};
+    for (int ci = 0; ci < 2; ++ci) {
+        for (int pi = 0; pi < kNumPieceTypes; ++pi) {
+            pieces[ci][pi] = board.pieces(static_cast<Color>(ci), static_cast<PieceType>(pi + 1));
+        }
+    }
+    return pieces;
+}
+
+void compute_attacks(const PieceBitboards& pieces, AttackMap& map) noexcept {
+    Bitboard occ = kEmptyBB;
+    for (const auto& color : pieces) {
+        for (Bitboard bb : color) occ |= bb;
+    }
+
+    for (int ci = 0; ci < 2; ++ci) {
+        Bitboard* attacked = map.attacked_by[ci];
+
+        Bitboard pawns = pieces[ci][0];
+        attacked[0] = (ci == 0) ? shift_ne(pawns) | shift_nw(pawns)  //
+                                : shift_se(pawns) | shift_sw(pawns);
+        Bitboard all = attacked[0];
+
+        for (int pi = 1; pi < kNumPieceTypes; ++pi) {
+            Bitboard bb = pieces[ci][pi];
+            Bitboard union_bb = kEmptyBB;
+            while (bb) {
+                Square sq = pop_lsb(bb);
+                Bitboard att = kEmptyBB;
+                switch (pi) {
+                    case 1:
+                        att = knight_attacks(sq);
+                        break;
+                    case 2:
+                        att = magic::bishop_attacks(sq, occ);
+                        break;
+                    case 3:
+                        att = magic::rook_attacks(sq, occ);
+                        break;
+                    case 4:
+                        att = magic::queen_attacks(sq, occ);
+                        break;
+                    default:
+                        att = king_attacks(sq);
+                        break;
+                }
+                map.attacks_from[sq] = att;
+                union_bb |= att;
+            }
+            attacked[pi] = union_bb;
+            all |= union_bb;
+        }
+        attacked[AttackMap::kAllPieces] = all;
+    }
+}
+
+AttackMap compute_attacks(const Board& board) noexcept {
+    AttackMap map;
+    compute_attacks(piece_bitboards(board), map);
+    return map;
+}
+
+}  // namespace chessie
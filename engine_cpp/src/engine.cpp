@@ -2,24 +2,182 @@
 /// Engine facade implementation.
 
 #include <chessie/engine.hpp>
+#include <chessie/engine_pool.hpp>
+
+#include <exception>
+#include <utility>
 
 namespace chessie {
 
+// ── SearchHandle ────────────────────────────────────────────────────────────
+
+void SearchHandle::wait() const {
+    std::unique_lock lock(mutex_);
+    finished_.wait(lock, [this] { return poll(); });
+}
+
+bool SearchHandle::wait(std::chrono::milliseconds timeout) const {
+    std::unique_lock lock(mutex_);
+    return finished_.wait_for(lock, timeout, [this] { return poll(); });
+}
+
+void SearchHandle::finish(SearchResult result, std::exception_ptr error) {
+    {
+        std::lock_guard lock(mutex_);
+        result_ = std::move(result);
+        error_ = std::move(error);
+        done_.store(true, std::memory_order_release);
+    }
+    finished_.notify_all();
+}
+
+// ── Engine ──────────────────────────────────────────────────────────────────
+
 Engine::Engine(std::size_t tt_mb) : search_(tt_mb) {}
 
+Engine::Engine(std::shared_ptr<TranspositionTable> tt) : search_(std::move(tt)) {}
+
+Engine::~Engine() {
+    std::unique_lock lock(worker_->mutex);
+    worker_->exit = true;
+    if (worker_->active)
+        worker_->active->stop();
+    lock.unlock();
+    worker_->wake.notify_one();
+    if (!worker_->thread.joinable())
+        return;
+    // Destroyed by a callback: the thread leaves once the callback returns.
+    if (worker_->thread.get_id() == std::this_thread::get_id())
+        worker_->thread.detach();
+    else
+        worker_->thread.join();
+}
+
 SearchResult Engine::search(Position& pos, const SearchLimits& limits) {
-    return search_.search(pos, limits);
+    join_search();
+    return run_search(pos, limits);
+}
+
+SearchResult Engine::run_search(Position& pos, const SearchLimits& limits) {
+    std::lock_guard lock(search_mutex_);
+    SearchResult result = search_.search(pos, limits);
+    std::lock_guard result_lock(worker_->mutex);
+    last_result_ = result;
+    return result;
+}
+
+SearchResult Engine::last_result() {
+    std::unique_lock lock(worker_->mutex);
+    stop_and_wait(lock);
+    return last_result_;
+}
+
+std::shared_ptr<SearchHandle> Engine::start_search(const Position& pos,
+                                                   const SearchLimits& limits,
+                                                   SearchCallback on_done) {
+    auto handle = std::make_shared<SearchHandle>();
+    SearchLimits async_limits = limits;
+    async_limits.stop_flag = &handle->stop_;
+
+    // One critical section from the wait to the hand-off, so concurrent
+    // callers queue one job after another.
+    std::unique_lock lock(worker_->mutex);
+    stop_and_wait(lock);
+    worker_->job = Job{pos, async_limits, std::move(on_done), handle};
+    worker_->active = handle;
+    if (!worker_->thread.joinable())
+        worker_->thread = std::thread(worker_loop, this, worker_);
+    lock.unlock();
+    worker_->wake.notify_one();
+    return handle;
+}
+
+void Engine::worker_loop(Engine* engine, std::shared_ptr<Worker> worker) {
+    std::unique_lock lock(worker->mutex);
+    for (;;) {
+        worker->wake.wait(lock, [&] { return worker->exit || worker->job; });
+        if (!worker->job)
+            return;
+        Job job = std::move(*worker->job);
+        worker->job.reset();
+        worker->busy = true;
+        if (worker->exit)
+            job.handle->stop();
+        lock.unlock();
+
+        SearchResult result;
+        std::exception_ptr error;
+        try {
+            result = engine->run_search(job.root, job.limits);
+        } catch (...) {
+            error = std::current_exception();
+        }
+        job.handle->finish(std::move(result), std::move(error));
+        // The callback may start another search or destroy the engine, so
+        // only `worker` may be touched below.
+        if (job.on_done)
+            job.on_done(job.handle->result());
+        // Release the callback (and what it captured) before reporting idle.
+        job.on_done = nullptr;
+        job.handle.reset();
+
+        lock.lock();
+        worker->busy = false;
+        worker->idle.notify_all();
+    }
+}
+
+void Engine::stop_and_wait(std::unique_lock<std::mutex>& lock) {
+    if (worker_->thread.get_id() == std::this_thread::get_id())
+        return;
+    while (worker_->busy || worker_->job) {
+        worker_->active->stop();
+        worker_->idle.wait(lock);
+    }
+}
+
+void Engine::join_search() {
+    std::unique_lock lock(worker_->mutex);
+    stop_and_wait(lock);
+}
+
+std::unique_lock<std::mutex> Engine::idle() {
+    join_search();
+    // A synchronous search on another thread holds the mutex until it
+    // returns. Cancel until it does: a search just starting clears the flag.
+    std::unique_lock lock(search_mutex_, std::defer_lock);
+    while (!lock.try_lock()) {
+        search_.cancel();
+        std::this_thread::yield();
+    }
+    return lock;
 }
 
 void Engine::cancel() noexcept {
     search_.cancel();
 }
 
+void Engine::set_heuristic_aging(bool enabled) {
+    const auto lock = idle();
+    search_.set_heuristic_reuse(enabled ? HeuristicReuse::Age : HeuristicReuse::Clear);
+}
+
 void Engine::set_tt_size(std::size_t mb) {
-    search_.tt().resize(mb);
+    if (pool_ != nullptr) {
+        const auto locks = pool_->idle_all();
+        search_.tt().rehash(mb);
+        return;
+    }
+    const auto lock = idle();
+    search_.tt().rehash(mb);
 }
 
 void Engine::clear_tt() {
+    if (pool_ != nullptr) {
+        pool_->clear_tt();
+        return;
+    }
+    const auto lock = idle();
     search_.tt().clear();
 }
 
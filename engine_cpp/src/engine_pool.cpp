@@ -0,0 +1,84 @@
+/// @file engine_pool.cpp
+/// Engine pool implementation.
+
+#include <chessie/engine_pool.hpp>
+#include <chessie/trace.hpp>
+
+#include <stdexcept>
+#include <string>
+
+namespace chessie {
+
+namespace {
+
+constexpr std::size_t kBytesPerMb = 1024ULL * 1024ULL;
+
+/// Memory a context uses beyond `sizeof(Engine)`, charged up front. Its
+/// root-move list and the copy in the last result hold at most 256 moves
+/// with a `kMaxPly` PV each (~300 KB); the search recursion touches a few
+/// hundred KB of its thread's stack. With tracing compiled in, the span
+/// ring of its search thread is added.
+constexpr std::size_t kContextReserveBytes =
+    kBytesPerMb + (trace::kEnabled ? trace::kRingCapacity * sizeof(trace::Event) : 0);
+
+constexpr std::size_t kContextBytes = sizeof(Engine) + kContextReserveBytes;
+
+/// Table size left of `budget_mb` once `contexts` engines are paid for.
+std::size_t table_budget_mb(std::size_t budget_mb, std::size_t contexts) {
+    const std::size_t context_bytes = contexts * kContextBytes;
+    const std::size_t context_mb = (context_bytes + kBytesPerMb - 1) / kBytesPerMb;
+    if (budget_mb < context_mb + 1) {
+        throw std::invalid_argument("EnginePool budget of " + std::to_string(budget_mb) +
+                                    " MB cannot hold " + std::to_string(contexts) +
+                                    " contexts and a table");
+    }
+    return budget_mb - context_mb;
+}
+
+}  // namespace
+
+EnginePool::EnginePool(std::size_t budget_mb, std::size_t contexts)
+    : budget_mb_(budget_mb),
+      tt_(std::make_shared<TranspositionTable>(table_budget_mb(budget_mb, contexts))) {
+    if (contexts == 0)
+        throw std::invalid_argument("EnginePool needs at least one context");
+    engines_.reserve(contexts);
+    for (std::size_t i = 0; i < contexts; ++i) {
+        engines_.push_back(std::make_unique<Engine>(tt_));
+        engines_.back()->pool_ = this;
+    }
+}
+
+Engine& EnginePool::engine(std::size_t i) {
+    if (i >= engines_.size())
+        throw std::out_of_range("EnginePool has no context " + std::to_string(i));
+    return *engines_[i];
+}
+
+std::size_t EnginePool::memory_bytes() const noexcept {
+    return tt_->size_bytes() + engines_.size() * kContextBytes;
+}
+
+void EnginePool::set_budget(std::size_t mb) {
+    const std::size_t table_mb = table_budget_mb(mb, engines_.size());
+    const auto locks = idle_all();
+    tt_->rehash(table_mb);
+    budget_mb_ = mb;
+}
+
+void EnginePool::clear_tt() {
+    const auto locks = idle_all();
+    tt_->clear();
+}
+
+std::vector<std::unique_lock<std::mutex>> EnginePool::idle_all() {
+    // Join every search thread before taking any lock: a finishing callback
+    // may itself call into the pool.
+    for (const auto& engine : engines_) engine->join_search();
+    std::vector<std::unique_lock<std::mutex>> locks;
+    locks.reserve(engines_.size());
+    for (const auto& engine : engines_) locks.push_back(engine->idle());
+    return locks;
+}
+
+}  // namespace chessie
@@ -0,0 +1,222 @@
+/// @file epd.cpp
+/// EPD record parsing and the test-suite runner.
+
+#include <chessie/epd.hpp>
+#include <chessie/movegen.hpp>
+#include <chessie/san.hpp>
+
+#include <algorithm>
+#include <atomic>
+#include <istream>
+#include <mutex>
+#include <sstream>
+#include <stdexcept>
+#include <thread>
+
+namespace chessie::epd {
+
+namespace {
+
+bool is_integer(std::string_view s) {
+    return !s.empty() &&
+           std::all_of(s.begin(), s.end(), [](char c) { return c >= '0' && c <= '9'; });
+}
+
+std::string_view trim(std::string_view s) {
+    const auto first = s.find_first_not_of(" \t\r\n");
+    if (first == std::string_view::npos)
+        return {};
+    const auto last = s.find_last_not_of(" \t\r\n");
+    return s.substr(first, last - first + 1);
+}
+
+/// Split the operation section at ';', ignoring separators inside quotes.
+std::vector<std::string_view> split_operations(std::string_view text) {
+    std::vector<std::string_view> ops;
+    bool quoted = false;
+    std::size_t start = 0;
+    for (std::size_t i = 0; i < text.size(); ++i) {
+        if (text[i] == '"') {
+            quoted = !quoted;
+        } else if (text[i] == ';' && !quoted) {
+            ops.push_back(text.substr(start, i - start));
+            start = i + 1;
+        }
+    }
+    ops.push_back(text.substr(start));
+    return ops;
+}
+
+/// A move operand in SAN or, failing that, UCI.
+Move parse_move(Position& pos, std::string_view text) {
+    try {
+        return san::parse(pos, text);
+    } catch (const std::invalid_argument&) {
+        for (const Move& m : movegen::legal(pos)) {
+            if (m.uci() == text)
+                return m;
+        }
+        throw;
+    }
+}
+
+std::vector<Move> parse_moves(Position& pos, std::string_view operand) {
+    std::vector<Move> moves;
+    std::istringstream words{std::string(operand)};
+    std::string word;
+    while (words >> word) moves.push_back(parse_move(pos, word));
+    return moves;
+}
+
+/// Index of the first iteration from which every later iteration chose a
+/// solution, or -1.
+int solution_iteration(const Record& record, const std::vector<IterationStats>& iterations) {
+    int first = -1;
+    for (int i = static_cast<int>(iterations.size()) - 1; i >= 0; --i) {
+        if (!record.is_solution(iterations[static_cast<std::size_t>(i)].best_move))
+            break;
+        first = i;
+    }
+    return first;
+}
+
+}  // namespace
+
+// ── Records ─────────────────────────────────────────────────────────────────
+
+bool Record::is_solution(Move m) const {
+    if (m.is_null())
+        return false;
+    if (std::find(avoid_moves.begin(), avoid_moves.end(), m) != avoid_moves.end())
+        return false;
+    if (best_moves.empty())
+        return true;
+    return std::find(best_moves.begin(), best_moves.end(), m) != best_moves.end();
+}
+
+Record parse_line(std::string_view line) {
+    std::istringstream fields{std::string(line)};
+    std::string board, side, castling, ep;
+    fields >> board >> side >> castling >> ep;
+    if (ep.empty())
+        throw std::invalid_argument("malformed EPD line: '" + std::string(line) + "'");
+
+    // Plain FEN lines carry the two clocks instead of operations.
+    std::string halfmove = "0";
+    std::string fullmove = "1";
+    std::string rest;
+    std::getline(fields, rest);
+    {
+        std::istringstream clocks{rest};
+        std::string a, b, tail;
+        clocks >> a >> b;
+        if (is_integer(a) && is_integer(b) && !(clocks >> tail)) {
+            halfmove = a;
+            fullmove = b;
+            rest.clear();
+        }
+    }
+
+    Record record;
+    for (std::string_view op : split_operations(rest)) {
+        op = trim(op);
+        if (op.empty())
+            continue;
+        const auto space = op.find_first_of(" \t");
+        std::string opcode(op.substr(0, space));
+        std::string_view operand =
+            space == std::string_view::npos ? std::string_view{} : trim(op.substr(space));
+        if (operand.size() >= 2 && operand.front() == '"' && operand.back() == '"')
+            operand = operand.substr(1, operand.size() - 2);
+
+        if (opcode == "hmvc" && is_integer(operand))
+            halfmove = operand;
+        else if (opcode == "fmvn" && is_integer(operand))
+            fullmove = operand;
+        else if (opcode == "id")
+            record.id = operand;
+        record.operations.emplace_back(std::move(opcode), std::string(operand));
+    }
+
+    Position pos = Position::from_fen(board + ' ' + side + ' ' + castling + ' ' + ep + ' ' +
+                                      halfmove + ' ' + fullmove);
+    record.fen = pos.to_fen();
+    for (const auto& [opcode, operand] : record.operations) {
+        if (opcode == "bm")
+            record.best_moves = parse_moves(pos, operand);
+        else if (opcode == "am")
+            record.avoid_moves = parse_moves(pos, operand);
+    }
+    return record;
+}
+
+std::vector<Record> read(std::istream& in) {
+    std::vector<Record> records;
+    std::string line;
+    while (std::getline(in, line)) {
+        const std::string_view text = trim(line);
+        if (text.empty() || text.front() == '#')
+            continue;
+        records.push_back(parse_line(text));
+    }
+    return records;
+}
+
+// ── Suite runner ────────────────────────────────────────────────────────────
+
+std::vector<PositionResult> run_suite(const std::vector<Record>& records, const RunConfig& config,
+                                      const ResultCallback& on_result) {
+    std::vector<PositionResult> results(records.size());
+    std::mutex mutex;
+    std::atomic<std::size_t> next{0};
+
+    auto worker = [&]() {
+        Engine engine(config.tt_mb);
+        engine.set_heuristic_aging(false);
+        for (;;) {
+            const std::size_t index = next.fetch_add(1);
+            if (index >= records.size())
+                break;
+
+            // Every position starts cold so results do not depend on the
+            // order in which workers pick them up.
+            const Record& record = records[index];
+            engine.clear_tt();
+            Position pos = Position::from_fen(record.fen);
+            const SearchResult sr = engine.search(pos, config.limits);
+
+            PositionResult result;
+            result.index = index;
+            result.move = sr.best_move;
+            result.depth = sr.depth;
+            result.nodes = sr.nodes;
+            result.time_ms = sr.time_ms;
+            result.solved = record.is_solution(sr.best_move);
+
+            const auto& iterations = sr.stats.iterations;
+            const int first = solution_iteration(record, iterations);
+            if (result.solved && first >= 0) {
+                const IterationStats& found = iterations[static_cast<std::size_t>(first)];
+                result.solution_depth = found.depth;
+                result.time_to_solution_ms = found.time_ms;
+                for (int i = 0; i <= first; ++i)
+                    result.nodes_to_solution += iterations[static_cast<std::size_t>(i)].nodes;
+            }
+
+            std::lock_guard lock(mutex);
+            results[index] = result;
+            if (on_result)
+                on_result(record, result);
+        }
+    };
+
+    const int threads =
+        std::clamp(config.threads, 1, std::max(static_cast<int>(records.size()), 1));
+    std::vector<std::thread> pool;
+    pool.reserve(static_cast<std::size_t>(threads));
+    for (int t = 0; t < threads; ++t) pool.emplace_back(worker);
+    for (auto& t : pool) t.join();
+    return results;
+}
+
+}  // namespace chessie::epd
@@ -0,0 +1,260 @@
+/// @file eval_batch.cpp
+/// Batched bit-plane evaluation kernels (AVX-512, AVX2 and scalar).
+
+#include <chessie/eval_batch.hpp>
+#include <chessie/evaluation.hpp>
+
+#include <algorithm>
+#include <bit>
+#include <stdexcept>
+
+#if defined(__AVX512F__) && defined(__AVX512VPOPCNTDQ__)
+#define CHESSIE_BATCH_AVX512 1
+#elif defined(__AVX2__)
+#define CHESSIE_BATCH_AVX2 1
+#endif
+
+#if defined(CHESSIE_BATCH_AVX512) || defined(CHESSIE_BATCH_AVX2)
+// GCC 12's AVX-512 headers trip -Wmaybe-uninitialized on their own
+// `_mm512_undefined_*` placeholders once inlined.
+#if defined(__GNUC__) && !defined(__clang__)
+#pragma GCC diagnostic push
+#pragma GCC diagnostic ignored "-Wmaybe-uninitialized"
+#endif
+#include <immintrin.h>
+#if defined(__GNUC__) && !defined(__clang__)
+#pragma GCC diagnostic pop
+#endif
+#endif
+
+namespace chessie::eval {
+
+// ── PositionBatch ───────────────────────────────────────────────────────────
+
+void PositionBatch::reserve(std::size_t capacity) {
+    for (auto& color : pieces_) {
+        for (auto& bbs : color) bbs.reserve(capacity);
+    }
+    side_.reserve(capacity);
+}
+
+void PositionBatch::clear() noexcept {
+    for (auto& color : pieces_) {
+        for (auto& bbs : color) bbs.clear();
+    }
+    side_.clear();
+}
+
+void PositionBatch::add(const Position& pos) {
+    const Board& board = pos.board();
+    for (int pi = 0; pi < kNumPieceTypes; ++pi) {
+        auto pt = static_cast<PieceType>(pi + 1);
+        pieces_[0][pi].push_back(board.pieces(Color::White, pt));
+        pieces_[1][pi].push_back(flip_vertical(board.pieces(Color::Black, pt)));
+    }
+    side_.push_back(static_cast<std::uint8_t>(color_index(pos.side_to_move())));
+}
+
+// ── BatchEvaluator ──────────────────────────────────────────────────────────
+
+BatchEvaluator::BatchEvaluator(const Params& params) : params_(params) {
+    for (int stage = 0; stage < 2; ++stage) {
+        Stage& st = stages_[stage];
+        for (int pi = 0; pi < kNumPieceTypes; ++pi) {
+            auto value = [&](int sq) -> std::int64_t {
+                const Score& s = params.pst(pi, sq);
+                return stage == 0 ? s.mg : s.eg;
+            };
+
+            std::int64_t lo = value(0);
+            for (int sq = 1; sq < 64; ++sq) lo = std::min(lo, value(sq));
+
+            const Score& piece = params.piece_value(pi);
+            st.base[pi] = static_cast<int>((stage == 0 ? piece.mg : piece.eg) + lo);
+
+            // Each square's excess over the minimum, split into binary planes.
+            for (int sq = 0; sq < 64; ++sq) {
+                auto excess = static_cast<std::uint64_t>(value(sq) - lo);
+                for (int bit = 0; excess != 0; ++bit, excess >>= 1) {
+                    if (excess & 1)
+                        set_bit(st.masks[bit][pi], static_cast<Square>(sq));
+                    st.num_planes = std::max(st.num_planes, bit + 1);
+                }
+            }
+        }
+    }
+}
+
+int BatchEvaluator::finish(const PositionBatch& batch, std::size_t i, std::int64_t mg,
+                           std::int64_t eg, std::int64_t phase) const {
+    PieceBitboards pieces;
+    for (int pi = 0; pi < kNumPieceTypes; ++pi) {
+        pieces[0][pi] = batch.pieces(Color::White, pi)[i];
+        pieces[1][pi] = flip_vertical(batch.pieces(Color::Black, pi)[i]);
+    }
+    // The attack terms stay scalar: one attack map per position.
+    AttackMap attacks;
+    compute_attacks(pieces, attacks);
+    const Score extra = attack_score(pieces, attacks, params_);
+    mg += extra.mg;
+    eg += extra.eg;
+
+    // Same tapering and rounding as evaluate().
+    phase = std::min<std::int64_t>(phase, kTotalPhase);
+    auto score = static_cast<int>((mg * phase + eg * (kTotalPhase - phase)) / kTotalPhase);
+    return batch.side_to_move(i) == Color::White ? score : -score;
+}
+
+void BatchEvaluator::evaluate_scalar(const PositionBatch& batch, std::size_t begin,
+                                     std::size_t end, int* out) const {
+    for (std::size_t i = begin; i < end; ++i) {
+        Bitboard white[kNumPieceTypes], black[kNumPieceTypes];
+        std::int64_t acc[2] = {0, 0};  // mg, eg (white perspective)
+        std::int64_t phase = 0;
+        for (int pi = 0; pi < kNumPieceTypes; ++pi) {
+            white[pi] = batch.pieces(Color::White, pi)[i];
+            black[pi] = batch.pieces(Color::Black, pi)[i];
+            int count_w = popcount(white[pi]);
+            int count_b = popcount(black[pi]);
+            phase += kPhaseWeight[pi] * (count_w + count_b);
+            for (int stage = 0; stage < 2; ++stage) {
+                acc[stage] +=
+                    static_cast<std::int64_t>(count_w - count_b) * stages_[stage].base[pi];
+            }
+        }
+
+        for (int stage = 0; stage < 2; ++stage) {
+            const Stage& st = stages_[stage];
+            for (int k = 0; k < st.num_planes; ++k) {
+                Bitboard plane_w = kEmptyBB;
+                Bitboard plane_b = kEmptyBB;
+                for (int pi = 0; pi < kNumPieceTypes; ++pi) {
+                    plane_w |= white[pi] & st.masks[k][pi];
+                    plane_b |= black[pi] & st.masks[k][pi];
+                }
+                int diff = popcount(plane_w) - popcount(plane_b);
+                acc[stage] += static_cast<std::int64_t>(diff) << k;
+            }
+        }
+        out[i] = finish(batch, i, acc[0], acc[1], phase);
+    }
+}
+
+void BatchEvaluator::evaluate(const PositionBatch& batch, std::span<int> out) const {
+    if (out.size() != batch.size()) {
+        throw std::invalid_argument("evaluate_batch: output size does not match batch size");
+    }
+    const std::size_t n = batch.size();
+    std::size_t i = 0;
+
+#if defined(CHESSIE_BATCH_AVX512)
+    // Eight positions per iteration, one per 64-bit lane.
+    alignas(64) std::int64_t mg[8], eg[8], ph[8];
+    for (; i + 8 <= n; i += 8) {
+        __m512i white[kNumPieceTypes], black[kNumPieceTypes];
+        __m512i acc[2] = {_mm512_setzero_si512(), _mm512_setzero_si512()};
+        __m512i phase = _mm512_setzero_si512();
+        for (int pi = 0; pi < kNumPieceTypes; ++pi) {
+            white[pi] = _mm512_loadu_si512(batch.pieces(Color::White, pi) + i);
+            black[pi] = _mm512_loadu_si512(batch.pieces(Color::Black, pi) + i);
+            __m512i count_w = _mm512_popcnt_epi64(white[pi]);
+            __m512i count_b = _mm512_popcnt_epi64(black[pi]);
+            phase = _mm512_add_epi64(phase, _mm512_mul_epi32(_mm512_add_epi64(count_w, count_b),
+                                                             _mm512_set1_epi64(kPhaseWeight[pi])));
+            __m512i count = _mm512_sub_epi64(count_w, count_b);
+            for (int stage = 0; stage < 2; ++stage) {
+                __m512i base = _mm512_set1_epi64(stages_[stage].base[pi]);
+                acc[stage] = _mm512_add_epi64(acc[stage], _mm512_mul_epi32(count, base));
+            }
+        }
+
+        for (int stage = 0; stage < 2; ++stage) {
+            const Stage& st = stages_[stage];
+            for (int k = 0; k < st.num_planes; ++k) {
+                __m512i plane_w = _mm512_setzero_si512();
+                __m512i plane_b = _mm512_setzero_si512();
+                for (int pi = 0; pi < kNumPieceTypes; ++pi) {
+                    __m512i mask = _mm512_set1_epi64(static_cast<long long>(st.masks[k][pi]));
+                    // 0xF8: plane | (pieces & mask) in one instruction.
+                    plane_w = _mm512_ternarylogic_epi64(plane_w, white[pi], mask, 0xF8);
+                    plane_b = _mm512_ternarylogic_epi64(plane_b, black[pi], mask, 0xF8);
+                }
+                __m512i diff = _mm512_sub_epi64(_mm512_popcnt_epi64(plane_w),
+                                                _mm512_popcnt_epi64(plane_b));
+                acc[stage] = _mm512_add_epi64(acc[stage], _mm512_slli_epi64(diff, k));
+            }
+        }
+
+        _mm512_store_si512(mg, acc[0]);
+        _mm512_store_si512(eg, acc[1]);
+        _mm512_store_si512(ph, phase);
+        for (std::size_t j = 0; j < 8; ++j) {
+            out[i + j] = finish(batch, i + j, mg[j], eg[j], ph[j]);
+        }
+    }
+#elif defined(CHESSIE_BATCH_AVX2)
+    // Four positions per iteration; popcount via nibble lookup + SAD.
+    const __m256i lookup = _mm256_setr_epi8(0, 1, 1, 2, 1, 2, 2, 3, 1, 2, 2, 3, 2, 3, 3, 4,  //
+                                            0, 1, 1, 2, 1, 2, 2, 3, 1, 2, 2, 3, 2, 3, 3, 4);
+    const __m256i low_nibbles = _mm256_set1_epi8(0x0F);
+    auto popcnt = [&](__m256i v) {
+        __m256i lo = _mm256_and_si256(v, low_nibbles);
+        __m256i hi = _mm256_and_si256(_mm256_srli_epi16(v, 4), low_nibbles);
+        __m256i bytes = _mm256_add_epi8(_mm256_shuffle_epi8(lookup, lo),
+                                        _mm256_shuffle_epi8(lookup, hi));
+        return _mm256_sad_epu8(bytes, _mm256_setzero_si256());
+    };
+
+    alignas(32) std::int64_t mg[4], eg[4], ph[4];
+    for (; i + 4 <= n; i += 4) {
+        __m256i white[kNumPieceTypes], black[kNumPieceTypes];
+        __m256i acc[2] = {_mm256_setzero_si256(), _mm256_setzero_si256()};
+        __m256i phase = _mm256_setzero_si256();
+        for (int pi = 0; pi < kNumPieceTypes; ++pi) {
+            white[pi] = _mm256_loadu_si256(
+                reinterpret_cast<const __m256i*>(batch.pieces(Color::White, pi) + i));
+            black[pi] = _mm256_loadu_si256(
+                reinterpret_cast<const __m256i*>(batch.pieces(Color::Black, pi) + i));
+            __m256i count_w = popcnt(white[pi]);
+            __m256i count_b = popcnt(black[pi]);
+            phase = _mm256_add_epi64(phase, _mm256_mul_epi32(_mm256_add_epi64(count_w, count_b),
+                                                             _mm256_set1_epi64x(kPhaseWeight[pi])));
+            __m256i count = _mm256_sub_epi64(count_w, count_b);
+            for (int stage = 0; stage < 2; ++stage) {
+                __m256i base = _mm256_set1_epi64x(stages_[stage].base[pi]);
+                acc[stage] = _mm256_add_epi64(acc[stage], _mm256_mul_epi32(count, base));
+            }
+        }
+
+        for (int stage = 0; stage < 2; ++stage) {
+            const Stage& st = stages_[stage];
+            for (int k = 0; k < st.num_planes; ++k) {
+                __m256i plane_w = _mm256_setzero_si256();
+                __m256i plane_b = _mm256_setzero_si256();
+                for (int pi = 0; pi < kNumPieceTypes; ++pi) {
+                    __m256i mask = _mm256_set1_epi64x(static_cast<long long>(st.masks[k][pi]));
+                    plane_w = _mm256_or_si256(plane_w, _mm256_and_si256(white[pi], mask));
+                    plane_b = _mm256_or_si256(plane_b, _mm256_and_si256(black[pi], mask));
+                }
+                __m256i diff = _mm256_sub_epi64(popcnt(plane_w), popcnt(plane_b));
+                acc[stage] = _mm256_add_epi64(acc[stage], _mm256_slli_epi64(diff, k));
+            }
+        }
+
+        _mm256_store_si256(reinterpret_cast<__m256i*>(mg), acc[0]);
+        _mm256_store_si256(reinterpret_cast<__m256i*>(eg), acc[1]);
+        _mm256_store_si256(reinterpret_cast<__m256i*>(ph), phase);
+        for (std::size_t j = 0; j < 4; ++j) {
+            out[i + j] = finish(batch, i + j, mg[j], eg[j], ph[j]);
+        }
+    }
+#endif
+
+    evaluate_scalar(batch, i, n, out.data());
+}
+
+void evaluate_batch(const PositionBatch& batch, std::span<int> out) {
+    BatchEvaluator(*params()).evaluate(batch, out);
+}
+
+}  // namespace chessie::eval
@@ -0,0 +1,214 @@
+/// @file eval_params.cpp
+/// Evaluation parameter naming, text I/O and constexpr-table export.
+
+#include <chessie/eval_params.hpp>
+
+#include <charconv>
+#include <cstdio>
+#include <fstream>
+#include <istream>
+#include <ostream>
+#include <stdexcept>
+#include <string>
+#include <string_view>
+
+namespace chessie::eval {
+
+namespace {
+
+constexpr std::string_view kPieceNames[] = {"pawn", "knight", "bishop", "rook", "queen", "king"};
+constexpr std::string_view kPieceTitles[] = {"Pawn", "Knight", "Bishop", "Rook", "Queen", "King"};
+
+/// Index of the first mobility term of Knight (pi=1) .. Queen (pi=4).
+constexpr int mobility_begin(int pi) {
+    return Params::mobility_index(pi, 0);
+}
+
+std::string_view trim(std::string_view sv) {
+    while (!sv.empty() && (sv.front() == ' ' || sv.front() == '\t' || sv.front() == '\r'))
+        sv.remove_prefix(1);
+    while (!sv.empty() && (sv.back() == ' ' || sv.back() == '\t' || sv.back() == '\r'))
+        sv.remove_suffix(1);
+    return sv;
+}
+
+/// Pop the next whitespace-delimited token off `sv`.
+std::string_view next_token(std::string_view& sv) {
+    sv = trim(sv);
+    std::size_t end = 0;
+    while (end < sv.size() && sv[end] != ' ' && sv[end] != '\t') ++end;
+    std::string_view token = sv.substr(0, end);
+    sv.remove_prefix(end);
+    return token;
+}
+
+int parse_weight(std::string_view sv, std::string_view line) {
+    int val = 0;
+    auto [ptr, ec] = std::from_chars(sv.data(), sv.data() + sv.size(), val);
+    if (sv.empty() || ec != std::errc{} || ptr != sv.data() + sv.size()) {
+        throw std::invalid_argument("Invalid weight in eval params: " + std::string(line));
+    }
+    return val;
+}
+
+/// Write the six per-piece row blocks of a [6][64] PST.
+void write_pst(std::ostream& out, const Params& params, bool mg) {
+    char buf[16];
+    for (int pi = 0; pi < kNumPieceTypes; ++pi) {
+        out << "    // " << kPieceTitles[pi] << "\n    {\n";
+        for (int row = 0; row < 8; ++row) {
+            out << "       ";
+            for (int col = 0; col < 8; ++col) {
+                const Score& s = params.pst(pi, row * 8 + col);
+                std::snprintf(buf, sizeof(buf), "%4d,", mg ? s.mg : s.eg);
+                out << buf;
+            }
+            out << '\n';
+        }
+        out << "    },\n";
+    }
+}
+
+/// Write `count` consecutive (mg, eg) terms as `{mg, eg},` items, 7 per row.
+void write_scores(std::ostream& out, const Params& params, int first, int count) {
+    char buf[32];
+    for (int i = 0; i < count; ++i) {
+        const Score& s = params.terms[static_cast<std::size_t>(first + i)];
+        std::snprintf(buf, sizeof(buf), "{%4d,%4d},", s.mg, s.eg);
+        out << (i % 7 == 0 ? "    " : " ") << buf;
+        if (i % 7 == 6 || i == count - 1)
+            out << '\n';
+    }
+}
+
+void write_piece_values(std::ostream& out, const Params& params, bool mg) {
+    char buf[16];
+    if (mg) {
+        // Column titles right-aligned over the values, behind a `//`.
+        std::string header = "    ";
+        for (std::string_view title : kPieceTitles) {
+            std::snprintf(buf, sizeof(buf), "%7.*s ", static_cast<int>(title.size()),
+                          title.data());
+            header += buf;
+        }
+        header[4] = '/';
+        header[5] = '/';
+        header.pop_back();
+        out << header << '\n';
+    }
+    out << "    ";
+    for (int pi = 0; pi < kNumPieceTypes; ++pi) {
+        const Score& s = params.piece_value(pi);
+        std::snprintf(buf, sizeof(buf), "%7d,", mg ? s.mg : s.eg);
+        out << buf;
+    }
+    out << '\n';
+}
+
+}  // namespace
+
+// ── Naming ──────────────────────────────────────────────────────────────────
+
+std::string term_name(int index) {
+    if (index >= Params::kPieceValueOffset && index < Params::kPstOffset) {
+        return "piece_value." + std::string(kPieceNames[index - Params::kPieceValueOffset]);
+    }
+    if (index >= Params::kPstOffset && index < Params::kMobilityOffset) {
+        int rel = index - Params::kPstOffset;
+        return "pst." + std::string(kPieceNames[rel / 64]) + "." +
+               square_name(static_cast<Square>(rel % 64));
+    }
+    if (index >= Params::kMobilityOffset && index < Params::kKingAttackOffset) {
+        int pi = 4;
+        while (index < mobility_begin(pi)) --pi;
+        return "mobility." + std::string(kPieceNames[pi]) + "." +
+               std::to_string(index - mobility_begin(pi));
+    }
+    if (index >= Params::kKingAttackOffset && index < Params::kNumTerms) {
+        return "king_attack." + std::to_string(index - Params::kKingAttackOffset);
+    }
+    return {};
+}
+
+int term_index(std::string_view name) {
+    for (int i = 0; i < Params::kNumTerms; ++i) {
+        if (term_name(i) == name)
+            return i;
+    }
+    return -1;
+}
+
+// ── Text I/O ────────────────────────────────────────────────────────────────
+
+void save_params(std::ostream& out, const Params& params) {
+    for (int i = 0; i < Params::kNumTerms; ++i) {
+        const Score& s = params.terms[static_cast<std::size_t>(i)];
+        out << term_name(i) << ' ' << s.mg << ' ' << s.eg << '\n';
+    }
+}
+
+void load_params(std::istream& in, Params& params) {
+    std::string raw;
+    while (std::getline(in, raw)) {
+        std::string_view line = trim(raw);
+        if (line.empty() || line.front() == '#')
+            continue;
+
+        std::string_view rest = line;
+        std::string_view name = next_token(rest);
+        std::string_view mg = next_token(rest);
+        std::string_view eg = next_token(rest);
+        if (!trim(rest).empty()) {
+            throw std::invalid_argument("Trailing data in eval params: " + std::string(line));
+        }
+
+        int index = term_index(name);
+        if (index < 0) {
+            throw std::invalid_argument("Unknown eval term: " + std::string(name));
+        }
+        params.terms[static_cast<std::size_t>(index)] = {parse_weight(mg, line),
+                                                         parse_weight(eg, line)};
+    }
+}
+
+void load_params_file(const std::string& path, Params& params) {
+    std::ifstream in(path);
+    if (!in) {
+        throw std::runtime_error("Cannot open eval params file: " + path);
+    }
+    load_params(in, params);
+}
+
+// ── Export ──────────────────────────────────────────────────────────────────
+
+void export_cpp(std::ostream& out, const Params& params) {
+    out << "// Middlegame piece values (centipawns).\n"
+           "constexpr int kPieceValueMG[] = {\n";
+    write_piece_values(out, params, true);
+    out << "};\n\n"
+           "// Endgame piece values (centipawns).\n"
+           "constexpr int kPieceValueEG[] = {\n";
+    write_piece_values(out, params, false);
+    out << "};\n\n"
+           "// Middlegame PST\n"
+           "constexpr int kMgPst[6][64] = {\n";
+    write_pst(out, params, true);
+    out << "};\n\n"
+           "// Endgame PST\n"
+           "constexpr int kEgPst[6][64] = {\n";
+    write_pst(out, params, false);
+    out << "};\n\n"
+           "// Mobility by safe-square count, {mg, eg}.\n"
+           "constexpr Score kMobility[] = {\n";
+    for (int pi = 1; pi <= 4; ++pi) {
+        out << "    // " << kPieceTitles[pi] << '\n';
+        write_scores(out, params, mobility_begin(pi), Params::kMobilitySize[pi - 1]);
+    }
+    out << "};\n\n"
+           "// King safety by attack units on the king zone, {mg, eg}.\n"
+           "constexpr Score kKingAttack[] = {\n";
+    write_scores(out, params, Params::kKingAttackOffset, Params::kKingAttackSize);
+    out << "};\n";
+}
+
+}  // namespace chessie::eval
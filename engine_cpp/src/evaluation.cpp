@@ -1,5 +1,6 @@
 /// @file evaluation.cpp
-/// Static position evaluation with PeSTO-style Piece-Square Tables.
+/// Static position evaluation: PeSTO-style Piece-Square Tables plus
+/// attack-map based mobility and king safety.
 ///
 /// PST values are based on the PeSTO evaluation tables by Ronald Friederich,
 /// which are widely used in open-source chess engines.
@@ -7,33 +8,35 @@
 #include <chessie/bitboard.hpp>
 #include <chessie/evaluation.hpp>
 
+#include <algorithm>
+#include <array>
+#include <memory>
+#include <mutex>
+
 namespace chessie::eval {
 
 // ── Material values ─────────────────────────────────────────────────────────
+// The tables below are in the format written by `export_cpp()`, so tuned
+// parameters (`chessie_tune --export`) can be pasted over them verbatim.
 
 // clang-format off
 
 // Middlegame piece values (centipawns).
 constexpr int kPieceValueMG[] = {
-    // Pawn  Knight  Bishop  Rook  Queen  King
-      82,    337,    365,   477,   1025,    0,
+    // Pawn  Knight  Bishop    Rook   Queen    King
+         82,    337,    365,    477,   1025,      0,
 };
 
 // Endgame piece values (centipawns).
 constexpr int kPieceValueEG[] = {
-      94,    281,    297,   512,    936,    0,
+         94,    281,    297,    512,    936,      0,
 };
 
-// Phase contribution per piece type (total phase = 24).
-// Pawn=0, Knight=1, Bishop=1, Rook=2, Queen=4, King=0
-constexpr int kPhaseWeight[] = { 0, 1, 1, 2, 4, 0 };
-constexpr int kTotalPhase = 24;
-
 // ── Piece-Square Tables ─────────────────────────────────────────────────────
 // Indexed as [piece_type_index][square], from WHITE's perspective (a1=0..h8=63).
 // For black, we mirror vertically: sq ^ 56.
 
-// PeSTO Middlegame PST
+// Middlegame PST
 constexpr int kMgPst[6][64] = {
     // Pawn
     {
@@ -103,7 +106,7 @@ constexpr int kMgPst[6][64] = {
     },
 };
 
-// PeSTO Endgame PST
+// Endgame PST
 constexpr int kEgPst[6][64] = {
     // Pawn
     {
@@ -172,50 +175,260 @@ constexpr int kEgPst[6][64] = {
         -53, -34, -21, -11, -28, -14, -24, -43,
     },
 };
+
+// ── Mobility and king safety ────────────────────────────────────────────────
+// Mobility counts attacked squares not occupied by own pieces and not
+// attacked by enemy pawns. King safety is scored only once at least two
+// enemy pieces hit the king zone (king square + neighbours).
+
+// Mobility by safe-square count, {mg, eg}.
+constexpr Score kMobility[] = {
+    // Knight
+    { -16, -16}, { -12, -12}, {  -8,  -8}, {  -4,  -4}, {   0,   0}, {   4,   4}, {   8,   8},
+    {  12,  12}, {  16,  16},
+    // Bishop
+    { -30, -30}, { -25, -25}, { -20, -20}, { -15, -15}, { -10, -10}, {  -5,  -5}, {   0,   0},
+    {   5,   5}, {  10,  10}, {  15,  15}, {  20,  20}, {  25,  25}, {  30,  30}, {  35,  35},
+    // Rook
+    { -12, -24}, { -10, -20}, {  -8, -16}, {  -6, -12}, {  -4,  -8}, {  -2,  -4}, {   0,   0},
+    {   2,   4}, {   4,   8}, {   6,  12}, {   8,  16}, {  10,  20}, {  12,  24}, {  14,  28},
+    {  16,  32},
+    // Queen
+    { -13, -26}, { -12, -24}, { -11, -22}, { -10, -20}, {  -9, -18}, {  -8, -16}, {  -7, -14},
+    {  -6, -12}, {  -5, -10}, {  -4,  -8}, {  -3,  -6}, {  -2,  -4}, {  -1,  -2}, {   0,   0},
+    {   1,   2}, {   2,   4}, {   3,   6}, {   4,   8}, {   5,  10}, {   6,  12}, {   7,  14},
+    {   8,  16}, {   9,  18}, {  10,  20}, {  11,  22}, {  12,  24}, {  13,  26}, {  14,  28},
+};
+
+// King safety by attack units on the king zone, {mg, eg}.
+constexpr Score kKingAttack[] = {
+    {   0,   0}, {  -1,  -1}, {  -2,  -2}, {  -3,  -3}, {  -5,  -4}, {  -8,  -5}, { -11,  -6},
+    { -15,  -7}, { -20,  -8}, { -25,  -9}, { -30, -10}, { -37, -11}, { -44, -12}, { -51, -13},
+    { -59, -14}, { -68, -15}, { -77, -16}, { -87, -17}, { -98, -18}, {-109, -19}, {-120, -20},
+    {-133, -21}, {-146, -22}, {-159, -23}, {-173, -24}, {-188, -25}, {-203, -26}, {-219, -27},
+    {-236, -28}, {-253, -29}, {-270, -30}, {-289, -31},
+};
 // clang-format on
 
-// ── Implementation ──────────────────────────────────────────────────────────
+// ── Parameter sets ──────────────────────────────────────────────────────────
 
-int evaluate(const Position& pos) {
-    const Board& board = pos.board();
+namespace {
 
-    int mg_score = 0;  // white perspective
-    int eg_score = 0;
+constexpr Params make_default_params() noexcept {
+    Params p{};
+    for (int pi = 0; pi < kNumPieceTypes; ++pi) {
+        p.piece_value(pi) = {kPieceValueMG[pi], kPieceValueEG[pi]};
+        for (int sq = 0; sq < 64; ++sq) {
+            p.pst(pi, sq) = {kMgPst[pi][sq], kEgPst[pi][sq]};
+        }
+    }
+    for (int i = 0; i < Params::kKingAttackOffset - Params::kMobilityOffset; ++i) {
+        p.terms[Params::kMobilityOffset + i] = kMobility[i];
+    }
+    for (int i = 0; i < Params::kKingAttackSize; ++i) {
+        p.king_attack(i) = kKingAttack[i];
+    }
+    return p;
+}
+
+static_assert(std::size(kMobility) == Params::kKingAttackOffset - Params::kMobilityOffset);
+static_assert(std::size(kKingAttack) == Params::kKingAttackSize);
+
+constexpr Params kDefaultParams = make_default_params();
+
+/// The active set. Replaced whole, never modified, so a snapshot taken by a
+/// search stays consistent while another thread installs a new one.
+std::shared_ptr<const Params> g_params = std::make_shared<const Params>(kDefaultParams);
+std::mutex g_params_mutex;
+
+/// King-attack units per king-zone square hit, by attacker (Pawn=0 .. King=5).
+constexpr int kKingAttackWeight[] = {0, 2, 2, 3, 5, 0};
+
+/// Mobility and king-safety terms, white perspective, added to `mg` / `eg`.
+/// With `kTrace` the coefficient of every term is also accumulated into `coefs`.
+template <bool kTrace>
+void evaluate_attacks(const PieceBitboards& pieces, const AttackMap& attacks,
+                      const Params& params, int& mg, int& eg, int* coefs) {
+    for (int us = 0; us < 2; ++us) {
+        const int them = us ^ 1;
+        const int sign = (us == 0) ? 1 : -1;
+
+        Bitboard own = kEmptyBB;
+        for (Bitboard bb : pieces[us]) own |= bb;
+        const Bitboard safe = ~own & ~attacks.attacked_by[them][0];
+
+        const Bitboard enemy_king = pieces[them][5];
+        const Bitboard zone = enemy_king ? king_attacks(lsb(enemy_king)) | enemy_king : kEmptyBB;
+        int units = 0;
+        int attackers = 0;
+
+        for (int pi = 1; pi <= 4; ++pi) {
+            Bitboard bb = pieces[us][pi];
+            while (bb) {
+                const Bitboard att = attacks.attacks_from[pop_lsb(bb)];
+                const int count = popcount(att & safe);
+                const Score& bonus = params.mobility(pi, count);
+                mg += sign * bonus.mg;
+                eg += sign * bonus.eg;
+                if constexpr (kTrace) {
+                    coefs[Params::mobility_index(pi, count)] += sign;
+                }
+
+                if (Bitboard hits = att & zone) {
+                    ++attackers;
+                    units += kKingAttackWeight[pi] * popcount(hits);
+                }
+            }
+        }
+
+        // The king-attack table scores the defending side.
+        if (attackers >= 2) {
+            units = std::min(units, Params::kKingAttackSize - 1);
+            const Score& safety = params.king_attack(units);
+            mg -= sign * safety.mg;
+            eg -= sign * safety.eg;
+            if constexpr (kTrace) {
+                coefs[Params::kKingAttackOffset + units] -= sign;
+            }
+        }
+    }
+}
+
+/// Tapered accumulators, white perspective.
+struct Tapered {
+    int mg = 0;
+    int eg = 0;
     int phase = 0;
+};
 
+/// Material + PST (the cheap tier). With `kTrace` the coefficient of every
+/// term is also accumulated into `coefs`.
+template <bool kTrace>
+void evaluate_material(const PieceBitboards& pieces, const Params& params, Tapered& acc,
+                       int* coefs) {
     for (int ci = 0; ci < 2; ++ci) {
         auto color = static_cast<Color>(ci);
         int sign = (color == Color::White) ? 1 : -1;
 
         for (int pi = 0; pi < kNumPieceTypes; ++pi) {
-            Bitboard pieces = board.pieces(color, static_cast<PieceType>(pi + 1));
+            Bitboard bb = pieces[ci][pi];
+            const Score value = params.piece_value(pi);
 
-            while (pieces) {
-                Square sq = pop_lsb(pieces);
+            while (bb) {
+                Square sq = pop_lsb(bb);
                 // For white, use sq directly; for black, mirror vertically.
                 int pst_sq = (color == Color::White) ? sq : (sq ^ 56);
+                const Score bonus = params.pst(pi, pst_sq);
 
-                mg_score += sign * (kPieceValueMG[pi] + kMgPst[pi][pst_sq]);
-                eg_score += sign * (kPieceValueEG[pi] + kEgPst[pi][pst_sq]);
-                phase += kPhaseWeight[pi];
+                acc.mg += sign * (value.mg + bonus.mg);
+                acc.eg += sign * (value.eg + bonus.eg);
+                acc.phase += kPhaseWeight[pi];
+
+                if constexpr (kTrace) {
+                    coefs[Params::kPieceValueOffset + pi] += sign;
+                    coefs[Params::kPstOffset + pi * 64 + pst_sq] += sign;
+                }
             }
         }
     }
 
     // Clamp phase to [0, kTotalPhase].
-    if (phase > kTotalPhase)
-        phase = kTotalPhase;
+    if (acc.phase > kTotalPhase)
+        acc.phase = kTotalPhase;
+}
+
+/// Tapered eval: interpolate between middlegame and endgame.
+/// phase == kTotalPhase → pure middlegame; phase == 0 → pure endgame.
+int taper(const Tapered& acc) {
+    return (acc.mg * acc.phase + acc.eg * (kTotalPhase - acc.phase)) / kTotalPhase;
+}
+
+/// Shared evaluation core, white perspective. With `kTrace` the coefficient
+/// of every term is also accumulated into `coefs`.
+template <bool kTrace>
+int evaluate_white(const PieceBitboards& pieces, const AttackMap& attacks, const Params& params,
+                   int* coefs, int& phase_out) {
+    Tapered acc;
+    evaluate_material<kTrace>(pieces, params, acc, coefs);
+    evaluate_attacks<kTrace>(pieces, attacks, params, acc.mg, acc.eg, coefs);
+    phase_out = acc.phase;
+    return taper(acc);
+}
 
-    // Tapered eval: interpolate between middlegame and endgame.
-    // phase == kTotalPhase → pure middlegame; phase == 0 → pure endgame.
-    int score = (mg_score * phase + eg_score * (kTotalPhase - phase)) / kTotalPhase;
+/// Side-to-move score of `pos` given its attack map.
+int evaluate_stm(const Position& pos, const AttackMap& attacks, const Params& params) {
+    int phase = 0;
+    int score =
+        evaluate_white<false>(piece_bitboards(pos.board()), attacks, params, nullptr, phase);
 
     // Return from side-to-move's perspective.
     return (pos.side_to_move() == Color::White) ? score : -score;
 }
 
+}  // namespace
+
+const Params& default_params() noexcept {
+    return kDefaultParams;
+}
+
+std::shared_ptr<const Params> params() {
+    std::lock_guard lock(g_params_mutex);
+    return g_params;
+}
+
+void set_params(const Params& params) {
+    auto replacement = std::make_shared<const Params>(params);
+    std::lock_guard lock(g_params_mutex);
+    g_params.swap(replacement);
+}
+
+// ── Implementation ──────────────────────────────────────────────────────────
+
+int evaluate(const Position& pos) {
+    return evaluate_stm(pos, compute_attacks(pos.board()), *params());
+}
+
+int evaluate(const Position& pos, const Params& params) {
+    return evaluate_stm(pos, compute_attacks(pos.board()), params);
+}
+
+int evaluate(const Position& pos, int alpha, int beta, EvalStats* stats) {
+    return evaluate(pos, *params(), alpha, beta, stats);
+}
+
+int evaluate(const Position& pos, const Params& params, int alpha, int beta, EvalStats* stats) {
+    const PieceBitboards pieces = piece_bitboards(pos.board());
+    const int sign = (pos.side_to_move() == Color::White) ? 1 : -1;
+
+    // Tier 1: material + PST. Return it when even a swing of kLazyMargin
+    // from the attack terms could not bring the score back into the window.
+    Tapered acc;
+    evaluate_material<false>(pieces, params, acc, nullptr);
+    const int core = sign * taper(acc);
+    if (core + kLazyMargin <= alpha || core - kLazyMargin >= beta) {
+        if (stats)
+            ++stats->lazy;
+        return core;
+    }
+
+    // Tier 2: attack map, mobility and king safety.
+    AttackMap attacks;
+    compute_attacks(pieces, attacks);
+    evaluate_attacks<false>(pieces, attacks, params, acc.mg, acc.eg, nullptr);
+    if (stats)
+        ++stats->full;
+    return sign * taper(acc);
+}
+
+Score attack_score(const PieceBitboards& pieces, const AttackMap& attacks, const Params& params) {
+    Score score;
+    evaluate_attacks<false>(pieces, attacks, params, score.mg, score.eg, nullptr);
+    return score;
+}
+
 int material(const Position& pos) {
     const Board& board = pos.board();
+    const std::shared_ptr<const Params> params = eval::params();
     int score = 0;
 
     for (int ci = 0; ci < 2; ++ci) {
@@ -224,11 +437,31 @@ int material(const Position& pos) {
 
         for (int pi = 0; pi < kNumPieceTypes; ++pi) {
             int count = popcount(board.pieces(color, static_cast<PieceType>(pi + 1)));
-            score += sign * kPieceValueMG[pi] * count;
+            score += sign * params->piece_value(pi).mg * count;
         }
     }
 
     return (pos.side_to_move() == Color::White) ? score : -score;
 }
 
+void trace(const Position& pos, Trace& out) {
+    trace(pos, *params(), out);
+}
+
+void trace(const Position& pos, const Params& params, Trace& out) {
+    std::array<int, Params::kNumTerms> coefs{};
+    PieceBitboards pieces = piece_bitboards(pos.board());
+    AttackMap attacks;
+    compute_attacks(pieces, attacks);
+    evaluate_white<true>(pieces, attacks, params, coefs.data(), out.phase);
+
+    out.terms.clear();
+    for (int i = 0; i < Params::kNumTerms; ++i) {
+        if (coefs[static_cast<std::size_t>(i)] != 0) {
+            out.terms.push_back({static_cast<std::uint16_t>(i),
+                                 static_cast<std::int16_t>(coefs[static_cast<std::size_t>(i)])});
+        }
+    }
+}
+
 }  // namespace chessie::eval
@@ -5,8 +5,10 @@
 /// This guarantees correctness regardless of the bit layout.
 
 #include <chessie/magic.hpp>
+#include <chessie/trace.hpp>
 
 #include <array>
+#include <cstddef>
 #include <cstdint>
 #include <vector>
 
@@ -89,20 +91,22 @@ Bitboard rook_mask(Square sq) {
 
 // ── Per-square magic entry ──────────────────────────────────────────────────
 
-struct MagicEntry {
+/// Everything one lookup touches: the entry holds a direct pointer into the
+/// shared attack table, so an attack lookup is one entry load plus one
+/// table load.
+struct alignas(32) MagicEntry {
     Bitboard mask{};
     std::uint64_t magic{};
+    const Bitboard* attacks{};
     int shift{};
-    int offset{};  // into the flat attack table
 };
 
 MagicEntry g_bishop_entries[64]{};
 MagicEntry g_rook_entries[64]{};
 
-// Flat attack tables (dynamically filled at init)
-// Bishop needs ~5248 entries; rook ~102400. We use vectors for simplicity.
-std::vector<Bitboard> g_bishop_table;
-std::vector<Bitboard> g_rook_table;
+/// One contiguous attack table for both piece types: bishop slices (~41 KB)
+/// first, then rook slices (~800 KB).
+std::vector<Bitboard> g_table;
 
 bool g_initialized = false;
 
@@ -159,9 +163,9 @@ std::uint64_t find_magic(Square /*sq*/, int bits, Bitboard mask, const std::vect
 
 // ── Init one piece type ─────────────────────────────────────────────────────
 
-void init_piece(MagicEntry* entries, std::vector<Bitboard>& table, bool is_rook, Rng& rng) {
-    int total_offset = 0;
-
+/// Append the slices of one piece type to the shared table. Entries keep
+/// their offsets in `offsets` until the table stops growing.
+void init_piece(MagicEntry* entries, int* offsets, bool is_rook, Rng& rng) {
     for (int sq = 0; sq < 64; ++sq) {
         auto s = static_cast<Square>(sq);
         Bitboard mask = is_rook ? rook_mask(s) : bishop_mask(s);
@@ -176,18 +180,14 @@ void init_piece(MagicEntry* entries, std::vector<Bitboard>& table, bool is_rook,
         entries[sq].mask = mask;
         entries[sq].magic = magic;
         entries[sq].shift = 64 - bits;
-        entries[sq].offset = total_offset;
-
-        int table_size = 1 << bits;
-        table.resize(static_cast<std::size_t>(total_offset + table_size), 0);
 
-        // Fill the table
+        const std::size_t offset = g_table.size();
+        offsets[sq] = static_cast<int>(offset);
+        g_table.resize(offset + (std::size_t{1} << bits), 0);
         for (std::size_t i = 0; i < occs.size(); ++i) {
-            int idx = static_cast<int>((occs[i] * magic) >> entries[sq].shift);
-            table[static_cast<std::size_t>(total_offset + idx)] = atks[i];
+            auto idx = static_cast<std::size_t>((occs[i] * magic) >> entries[sq].shift);
+            g_table[offset + idx] = atks[i];
         }
-
-        total_offset += table_size;
     }
 }
 
@@ -198,24 +198,28 @@ void init_piece(MagicEntry* entries, std::vector<Bitboard>& table, bool is_rook,
 void init() {
     if (g_initialized)
         return;
+    CHESSIE_TRACE_SCOPE("magic_init");
     Rng rng(0x12345678ABCDEF01ULL);
-    init_piece(g_bishop_entries, g_bishop_table, false, rng);
-    init_piece(g_rook_entries, g_rook_table, true, rng);
+    int bishop_offsets[64];
+    int rook_offsets[64];
+    g_table.reserve(5248 + 102400);
+    init_piece(g_bishop_entries, bishop_offsets, false, rng);
+    init_piece(g_rook_entries, rook_offsets, true, rng);
+    for (int sq = 0; sq < 64; ++sq) {
+        g_bishop_entries[sq].attacks = g_table.data() + bishop_offsets[sq];
+        g_rook_entries[sq].attacks = g_table.data() + rook_offsets[sq];
+    }
     g_initialized = true;
 }
 
 Bitboard bishop_attacks(Square sq, Bitboard occupancy) noexcept {
-    const auto& e = g_bishop_entries[sq];
-    auto idx = static_cast<std::size_t>(
-        e.offset + static_cast<int>(((occupancy & e.mask) * e.magic) >> e.shift));
-    return g_bishop_table[idx];
+    const MagicEntry& e = g_bishop_entries[sq];
+    return e.attacks[((occupancy & e.mask) * e.magic) >> e.shift];
 }
 
 Bitboard rook_attacks(Square sq, Bitboard occupancy) noexcept {
-    const auto& e = g_rook_entries[sq];
-    auto idx = static_cast<std::size_t>(
-        e.offset + static_cast<int>(((occupancy & e.mask) * e.magic) >> e.shift));
-    return g_rook_table[idx];
+    const MagicEntry& e = g_rook_entries[sq];
+    return e.attacks[((occupancy & e.mask) * e.magic) >> e.shift];
 }
 
 }  // namespace chessie::magic
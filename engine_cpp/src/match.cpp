@@ -0,0 +1,413 @@
+/// @file match.cpp
+/// Engine-vs-engine game play, PGN I/O and SPRT statistics.
+
+#include <chessie/epd.hpp>
+#include <chessie/match.hpp>
+#include <chessie/movegen.hpp>
+#include <chessie/san.hpp>
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cmath>
+#include <cstdio>
+#include <istream>
+#include <mutex>
+#include <stdexcept>
+#include <thread>
+
+namespace chessie::match {
+
+namespace {
+
+constexpr int kPgnLineWidth = 80;
+
+/// Share of the remaining clock spent on one move.
+constexpr std::int64_t kClockMovesToGo = 20;
+
+Outcome win_for(Color c) noexcept {
+    return c == Color::White ? Outcome::WhiteWins : Outcome::BlackWins;
+}
+
+/// Today's date in PGN format, "YYYY.MM.DD".
+std::string pgn_date() {
+    using namespace std::chrono;
+    const year_month_day ymd{floor<days>(system_clock::now())};
+    char buf[16];
+    std::snprintf(buf, sizeof(buf), "%04d.%02u.%02u", static_cast<int>(ymd.year()),
+                  static_cast<unsigned>(ymd.month()), static_cast<unsigned>(ymd.day()));
+    return buf;
+}
+
+/// Replay PGN movetext from `start_fen`, returning the final position.
+std::string replay_movetext(const std::string& start_fen, const std::string& movetext) {
+    Position pos = Position::from_fen(start_fen);
+    std::string token;
+    int variation_depth = 0;
+    bool in_comment = false;
+
+    auto flush = [&]() {
+        if (token.empty())
+            return;
+        std::string_view t = token;
+        // Move numbers ("12." / "12..."), results, NAGs.
+        std::size_t digits = 0;
+        while (digits < t.size() && t[digits] >= '0' && t[digits] <= '9') ++digits;
+        if (digits > 0 && digits < t.size() && t[digits] == '.') {
+            const std::size_t rest = t.find_first_not_of('.', digits);
+            t = rest == std::string_view::npos ? std::string_view{} : t.substr(rest);
+        }
+        if (!t.empty() && t != "1-0" && t != "0-1" && t != "1/2-1/2" && t != "*" &&
+            t.front() != '$') {
+            pos.make_move(san::parse(pos, t));
+        }
+        token.clear();
+    };
+
+    for (std::size_t i = 0; i < movetext.size(); ++i) {
+        const char c = movetext[i];
+        if (in_comment) {
+            in_comment = c != '}';
+        } else if (c == '{') {
+            flush();
+            in_comment = true;
+        } else if (c == ';') {
+            flush();
+            while (i < movetext.size() && movetext[i] != '\n') ++i;
+        } else if (c == '(') {
+            flush();
+            ++variation_depth;
+        } else if (c == ')') {
+            flush();
+            variation_depth = std::max(0, variation_depth - 1);
+        } else if (variation_depth > 0) {
+            continue;
+        } else if (c == ' ' || c == '\t' || c == '\n' || c == '\r') {
+            flush();
+        } else {
+            token += c;
+        }
+    }
+    flush();
+    return pos.to_fen();
+}
+
+}  // namespace
+
+// ── Games ───────────────────────────────────────────────────────────────────
+
+std::string_view result_string(Outcome outcome) noexcept {
+    switch (outcome) {
+        case Outcome::WhiteWins:
+            return "1-0";
+        case Outcome::BlackWins:
+            return "0-1";
+        default:
+            return "1/2-1/2";
+    }
+}
+
+GameRecord play_game(Engine& white, const EngineConfig& white_config, Engine& black,
+                     const EngineConfig& black_config, std::string_view start_fen, int max_plies) {
+    Engine* engines[2] = {&white, &black};
+    const EngineConfig* configs[2] = {&white_config, &black_config};
+    std::int64_t clock_ms[2] = {white_config.base_ms, black_config.base_ms};
+    for (int side = 0; side < 2; ++side) {
+        engines[side]->clear_tt();
+        engines[side]->set_heuristic_aging(configs[side]->heuristic_aging);
+    }
+
+    GameRecord game;
+    game.white = white_config.name;
+    game.black = black_config.name;
+    Position pos = Position::from_fen(start_fen);
+    game.start_fen = pos.to_fen();
+
+    for (int ply = 0;; ++ply) {
+        const Color us = pos.side_to_move();
+        MoveList legal = movegen::legal(pos);
+        if (legal.empty()) {
+            const bool mate = pos.is_in_check();
+            game.outcome = mate ? win_for(opposite(us)) : Outcome::Draw;
+            game.termination = mate ? "checkmate" : "stalemate";
+            break;
+        }
+        if (pos.halfmove_clock() >= 100) {
+            game.termination = "fifty-move rule";
+            break;
+        }
+        if (pos.repetition_count() >= 3) {
+            game.termination = "threefold repetition";
+            break;
+        }
+        if (pos.is_insufficient_material()) {
+            game.termination = "insufficient material";
+            break;
+        }
+        if (ply >= max_plies) {
+            game.termination = "adjudicated draw (max plies)";
+            break;
+        }
+
+        const int side = color_index(us);
+        const EngineConfig& config = *configs[side];
+        SearchLimits limits = config.limits;
+        if (config.base_ms > 0) {
+            std::int64_t budget =
+                std::max<std::int64_t>(clock_ms[side] / kClockMovesToGo + config.inc_ms / 2, 1);
+            if (limits.time_limit_ms > 0)
+                budget = std::min(budget, limits.time_limit_ms);
+            limits.time_limit_ms = budget;
+        }
+
+        Position root = pos;
+        const auto t0 = std::chrono::steady_clock::now();
+        const Move m = engines[side]->search(root, limits).best_move;
+        const auto elapsed = std::chrono::duration_cast<std::chrono::milliseconds>(
+                                 std::chrono::steady_clock::now() - t0)
+                                 .count();
+
+        if (config.base_ms > 0) {
+            clock_ms[side] -= elapsed;
+            if (clock_ms[side] < 0) {
+                game.outcome = win_for(opposite(us));
+                game.termination = "time forfeit";
+                break;
+            }
+            clock_ms[side] += config.inc_ms;
+        }
+        if (std::find(legal.begin(), legal.end(), m) == legal.end()) {
+            game.outcome = win_for(opposite(us));
+            game.termination = "illegal move";
+            break;
+        }
+
+        game.san.push_back(san::format(pos, m));
+        pos.make_move(m);
+    }
+    return game;
+}
+
+std::string to_pgn(const GameRecord& game) {
+    std::string out;
+    auto tag = [&out](std::string_view name, std::string_view value) {
+        out += '[';
+        out += name;
+        out += " \"";
+        out += value;
+        out += "\"]\n";
+    };
+    const std::string_view result = result_string(game.outcome);
+    tag("Event", "chessie match");
+    tag("Site", "?");
+    tag("Date", pgn_date());
+    tag("Round", std::to_string(game.round));
+    tag("White", game.white);
+    tag("Black", game.black);
+    tag("Result", result);
+    if (game.start_fen != kStartingFen) {
+        tag("SetUp", "1");
+        tag("FEN", game.start_fen);
+    }
+    tag("PlyCount", std::to_string(game.san.size()));
+    tag("Termination", game.termination);
+    out += '\n';
+
+    const Position start = Position::from_fen(game.start_fen);
+    int move_number = start.fullmove_number();
+    bool white_to_move = start.side_to_move() == Color::White;
+
+    std::string line;
+    auto emit = [&](const std::string& word) {
+        if (!line.empty() && line.size() + 1 + word.size() > kPgnLineWidth) {
+            out += line;
+            out += '\n';
+            line.clear();
+        }
+        if (!line.empty())
+            line += ' ';
+        line += word;
+    };
+    for (std::size_t i = 0; i < game.san.size(); ++i) {
+        if (white_to_move) {
+            emit(std::to_string(move_number) + ". " + game.san[i]);
+        } else {
+            emit(i == 0 ? std::to_string(move_number) + "... " + game.san[i] : game.san[i]);
+            ++move_number;
+        }
+        white_to_move = !white_to_move;
+    }
+    emit(std::string(result));
+    out += line;
+    out += "\n\n";
+    return out;
+}
+
+// ── Openings ────────────────────────────────────────────────────────────────
+
+std::vector<std::string> read_openings(std::istream& in) {
+    std::vector<std::string> openings;
+    std::string line;
+    std::string movetext;
+    std::string start_fen(kStartingFen);
+    bool in_pgn = false;
+
+    auto finish_pgn = [&]() {
+        if (in_pgn)
+            openings.push_back(replay_movetext(start_fen, movetext));
+        in_pgn = false;
+        movetext.clear();
+        start_fen = kStartingFen;
+    };
+
+    bool seen_movetext = false;
+    while (std::getline(in, line)) {
+        if (!line.empty() && line.back() == '\r')
+            line.pop_back();
+        const auto first = line.find_first_not_of(" \t");
+        if (first == std::string::npos || line[first] == '#' || line[first] == '%')
+            continue;
+
+        if (line[first] == '[') {
+            // A tag after movetext starts the next game.
+            if (seen_movetext)
+                finish_pgn();
+            seen_movetext = false;
+            in_pgn = true;
+            if (line.compare(first, 5, "[FEN ") == 0) {
+                const auto open = line.find('"');
+                const auto close = line.rfind('"');
+                if (open == std::string::npos || close <= open)
+                    throw std::invalid_argument("malformed FEN tag: '" + line + "'");
+                start_fen = line.substr(open + 1, close - open - 1);
+            }
+        } else if (in_pgn) {
+            seen_movetext = true;
+            movetext += line;
+            movetext += '\n';
+        } else {
+            openings.push_back(epd::parse_line(line).fen);
+        }
+    }
+    finish_pgn();
+    return openings;
+}
+
+// ── Statistics ──────────────────────────────────────────────────────────────
+
+double Tally::score() const noexcept {
+    const int n = games();
+    return n == 0 ? 0.5 : (wins + 0.5 * draws) / n;
+}
+
+double expected_score(double elo) noexcept {
+    return 1.0 / (1.0 + std::pow(10.0, -elo / 400.0));
+}
+
+double elo_from_score(double score) noexcept {
+    constexpr double kEpsilon = 1e-6;
+    score = std::clamp(score, kEpsilon, 1.0 - kEpsilon);
+    return -400.0 * std::log10(1.0 / score - 1.0);
+}
+
+namespace {
+
+/// Per-game variance of the score.
+double score_variance(const Tally& tally) noexcept {
+    const double n = tally.games();
+    const double w = tally.wins / n;
+    const double d = tally.draws / n;
+    const double s = tally.score();
+    return w + d / 4.0 - s * s;
+}
+
+}  // namespace
+
+double elo_error_95(const Tally& tally) noexcept {
+    if (tally.games() == 0)
+        return 0.0;
+    const double se = std::sqrt(score_variance(tally) / tally.games());
+    const double s = tally.score();
+    return (elo_from_score(s + 1.96 * se) - elo_from_score(s - 1.96 * se)) / 2.0;
+}
+
+double sprt_llr(const Tally& tally, double elo0, double elo1) noexcept {
+    if (tally.games() == 0)
+        return 0.0;
+    const double variance = score_variance(tally) / tally.games();
+    if (variance <= 0.0)
+        return 0.0;
+    const double s0 = expected_score(elo0);
+    const double s1 = expected_score(elo1);
+    return (s1 - s0) * (2.0 * tally.score() - s0 - s1) / (2.0 * variance);
+}
+
+SprtDecision sprt_decision(double llr, const SprtConfig& config) noexcept {
+    const double lower = std::log(config.beta / (1.0 - config.alpha));
+    const double upper = std::log((1.0 - config.beta) / config.alpha);
+    if (llr >= upper)
+        return SprtDecision::AcceptH1;
+    if (llr <= lower)
+        return SprtDecision::AcceptH0;
+    return SprtDecision::Continue;
+}
+
+// ── Match ───────────────────────────────────────────────────────────────────
+
+MatchResult run_match(const MatchConfig& config, const GameCallback& on_game) {
+    const std::vector<std::string> openings =
+        config.openings.empty() ? std::vector<std::string>{std::string(kStartingFen)}
+                                : config.openings;
+
+    MatchResult result;
+    std::mutex mutex;
+    std::atomic<int> next_game{0};
+    std::atomic<bool> stop{false};
+
+    auto worker = [&]() {
+        Engine first(config.first.tt_mb);
+        Engine second(config.second.tt_mb);
+        for (;;) {
+            const int index = next_game.fetch_add(1);
+            if (index >= config.games || stop.load())
+                break;
+
+            // Each opening is played twice, once with either colour.
+            const std::size_t opening = static_cast<std::size_t>(index / 2) % openings.size();
+            const std::string& fen = openings[opening];
+            const bool first_is_white = index % 2 == 0;
+            GameRecord game =
+                first_is_white
+                    ? play_game(first, config.first, second, config.second, fen, config.max_plies)
+                    : play_game(second, config.second, first, config.first, fen, config.max_plies);
+            game.round = index + 1;
+            game.first_is_white = first_is_white;
+
+            std::lock_guard lock(mutex);
+            if (game.outcome == Outcome::Draw) {
+                ++result.tally.draws;
+            } else if ((game.outcome == Outcome::WhiteWins) == first_is_white) {
+                ++result.tally.wins;
+            } else {
+                ++result.tally.losses;
+            }
+            if (config.sprt) {
+                result.llr = sprt_llr(result.tally, config.sprt->elo0, config.sprt->elo1);
+                result.decision = sprt_decision(result.llr, *config.sprt);
+                if (result.decision != SprtDecision::Continue)
+                    stop.store(true);
+            }
+            if (on_game)
+                on_game(game, result.tally);
+        }
+    };
+
+    const int threads = std::clamp(config.concurrency, 1, std::max(config.games, 1));
+    std::vector<std::thread> pool;
+    pool.reserve(static_cast<std::size_t>(threads));
+    for (int t = 0; t < threads; ++t) pool.emplace_back(worker);
+    for (auto& t : pool) t.join();
+    return result;
+}
+
+}  // namespace chessie::match
@@ -155,7 +155,7 @@ void gen_castling(const Position& pos, MoveList& ml) {
     const int rank = (us == Color::White) ? 0 : 7;
 
     // Can't castle while in check
-    if (pos.is_square_attacked(king_sq, them))
+    if (pos.is_in_check())
         return;
 
     // Kingside
@@ -257,14 +257,9 @@ MoveList pseudo_legal(const Position& pos) {
 MoveList legal(Position& pos) {
     MoveList pseudo = pseudo_legal(pos);
     MoveList result;
-    Color us = pos.side_to_move();
-
     for (const Move& m : pseudo) {
-        pos.make_move(m);
-        if (!pos.is_in_check(us)) {
+        if (pos.is_legal(m))
             result.push(m);
-        }
-        pos.unmake_move(m);
     }
     return result;
 }
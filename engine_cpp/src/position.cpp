@@ -48,7 +48,7 @@ int parse_int(std::string_view sv, int min_val = 0) {
 
 // ── Constructors ────────────────────────────────────────────────────────────
 
-Position::Position(Board board, Color side, CastlingRights castling, Square ep, int halfmove,
+Position::Position(const Board& board, Color side, CastlingRights castling, Square ep, int halfmove,
                    int fullmove)
     : board_(board),
       side_to_move_(side),
@@ -58,6 +58,7 @@ Position::Position(Board board, Color side, CastlingRights castling, Square ep,
       fullmove_number_(fullmove),
       key_(0) {
     compute_key();
+    update_check_state();
 }
 
 Position::Position()
@@ -248,7 +249,8 @@ void Position::make_move(Move m) {
     }
 
     // Save undo state
-    history_.push_back({castling_, en_passant_, halfmove_clock_, captured, key_});
+    history_.push_back({castling_, en_passant_, halfmove_clock_, captured, key_, checkers_,
+                        {blockers_for_king_[0], blockers_for_king_[1]}});
 
     // Remove moving piece from origin
     toggle_piece_hash(piece, m.from_sq);
@@ -315,6 +317,7 @@ void Position::make_move(Move m) {
     // Switch side
     side_to_move_ = opposite(side_to_move_);
     toggle_side_hash();
+    update_check_state();
 
     // Record key for repetition detection
     key_history_.push_back(key_);
@@ -381,6 +384,9 @@ void Position::unmake_move(Move m) {
     en_passant_ = undo.en_passant;
     halfmove_clock_ = undo.halfmove_clock;
     key_ = undo.key;
+    checkers_ = undo.checkers;
+    blockers_for_king_[0] = undo.blockers_for_king[0];
+    blockers_for_king_[1] = undo.blockers_for_king[1];
 }
 
 // ── Attack queries ──────────────────────────────────────────────────────────
@@ -422,26 +428,285 @@ bool Position::is_square_attacked(Square sq, Color by) const noexcept {
     return false;
 }
 
-bool Position::is_in_check() const noexcept {
-    return is_in_check(side_to_move_);
-}
-
 bool Position::is_in_check(Color c) const noexcept {
+    if (c == side_to_move_)
+        return is_in_check();
     return is_square_attacked(board_.king_square(c), opposite(c));
 }
 
+void Position::update_check_state() noexcept {
+    const Bitboard occ = board_.occupied_all();
+    checkers_ = kEmptyBB;
+    for (Color c : {Color::White, Color::Black}) {
+        Bitboard& blockers = blockers_for_king_[color_index(c)];
+        blockers = kEmptyBB;
+        const Bitboard king = board_.pieces(c, PieceType::King);
+        if (king == kEmptyBB)
+            continue;
+        const Square ksq = lsb(king);
+        const Color them = opposite(c);
+
+        // Enemy sliders that would see the king on an empty board: with
+        // nothing in between they give check, with one piece they are held
+        // back by a blocker. Table lookups only, so no magic::init() needed.
+        const Bitboard queens = board_.pieces(them, PieceType::Queen);
+        Bitboard snipers =
+            (rook_rays(ksq) & (board_.pieces(them, PieceType::Rook) | queens)) |
+            (bishop_rays(ksq) & (board_.pieces(them, PieceType::Bishop) | queens));
+        Bitboard slider_checks = kEmptyBB;
+        while (snipers) {
+            const Square sniper = pop_lsb(snipers);
+            const Bitboard between = between_bb(ksq, sniper) & occ;
+            if (between == kEmptyBB)
+                slider_checks |= square_bb(sniper);
+            else if (!more_than_one(between))
+                blockers |= between;
+        }
+
+        if (c == side_to_move_) {
+            checkers_ = (pawn_attacks(c, ksq) & board_.pieces(them, PieceType::Pawn)) |
+                        (knight_attacks(ksq) & board_.pieces(them, PieceType::Knight)) |
+                        slider_checks;
+        }
+    }
+}
+
+Bitboard Position::attackers_to(Square sq, Bitboard occ) const noexcept {
+    const Bitboard queens = board_.pieces(PieceType::Queen);
+    return (pawn_attacks(Color::Black, sq) & board_.pieces(Color::White, PieceType::Pawn)) |
+           (pawn_attacks(Color::White, sq) & board_.pieces(Color::Black, PieceType::Pawn)) |
+           (knight_attacks(sq) & board_.pieces(PieceType::Knight)) |
+           (king_attacks(sq) & board_.pieces(PieceType::King)) |
+           (magic::rook_attacks(sq, occ) & (board_.pieces(PieceType::Rook) | queens)) |
+           (magic::bishop_attacks(sq, occ) & (board_.pieces(PieceType::Bishop) | queens));
+}
+
+// ── Move validation ─────────────────────────────────────────────────────────
+
+bool Position::is_pseudo_legal(Move m) const noexcept {
+    const Color us = side_to_move_;
+    const Color them = opposite(us);
+    const Square from = m.from_sq;
+    const Square to = m.to_sq;
+    if (from >= 64 || to >= 64 || from == to)
+        return false;
+
+    const Piece piece = board_.piece_at(from);
+    if (piece.type == PieceType::None || piece.color != us)
+        return false;
+    if (test_bit(board_.occupied(us), to))
+        return false;
+    if ((m.flag == MoveFlag::Promotion) != (m.promotion != PieceType::None))
+        return false;
+
+    const Bitboard occ = board_.occupied_all();
+    const Bitboard enemy = board_.occupied(them);
+    const int forward = us == Color::White ? 8 : -8;
+    const Bitboard last_rank = us == Color::White ? kRank8 : kRank1;
+
+    if (piece.type == PieceType::Pawn) {
+        const bool push = to == from + forward && !test_bit(occ, to);
+        const bool capture = test_bit(pawn_attacks(us, from) & enemy, to);
+        switch (m.flag) {
+            case MoveFlag::Normal:
+                return (push || capture) && !test_bit(last_rank, to);
+            case MoveFlag::Promotion:
+                return (push || capture) && test_bit(last_rank, to) &&
+                       m.promotion != PieceType::Pawn && m.promotion != PieceType::King;
+            case MoveFlag::DoublePawn: {
+                const Bitboard start_rank = us == Color::White ? kRank2 : kRank7;
+                return test_bit(start_rank, from) && to == from + 2 * forward &&
+                       !test_bit(occ, from + forward) && !test_bit(occ, to);
+            }
+            case MoveFlag::EnPassant:
+                return to == en_passant_ && test_bit(pawn_attacks(us, from), to);
+            default:
+                return false;
+        }
+    }
+
+    if (m.flag == MoveFlag::CastleKingside || m.flag == MoveFlag::CastleQueenside) {
+        // The same conditions gen_castling applies.
+        const int rank = us == Color::White ? 0 : 7;
+        const bool kingside = m.flag == MoveFlag::CastleKingside;
+        const CastlingRights right = us == Color::White
+                                         ? (kingside ? kWhiteKingside : kWhiteQueenside)
+                                         : (kingside ? kBlackKingside : kBlackQueenside);
+        const Square rook_sq = make_square(kingside ? 7 : 0, rank);
+        if (piece.type != PieceType::King || from != make_square(4, rank) ||
+            to != make_square(kingside ? 6 : 2, rank) || !(castling_ & right) ||
+            board_.piece_at(rook_sq) != Piece{us, PieceType::Rook} || is_in_check()) {
+            return false;
+        }
+        if (between_bb(from, rook_sq) & occ)
+            return false;
+        const Square pass = make_square(kingside ? 5 : 3, rank);
+        const Bitboard attackers = board_.occupied(them);
+        return !(attackers_to(pass, occ) & attackers) && !(attackers_to(to, occ) & attackers);
+    }
+    if (m.flag != MoveFlag::Normal)
+        return false;
+
+    Bitboard targets = kEmptyBB;
+    switch (piece.type) {
+        case PieceType::Knight:
+            targets = knight_attacks(from);
+            break;
+        case PieceType::Bishop:
+            targets = magic::bishop_attacks(from, occ);
+            break;
+        case PieceType::Rook:
+            targets = magic::rook_attacks(from, occ);
+            break;
+        case PieceType::Queen:
+            targets = magic::queen_attacks(from, occ);
+            break;
+        case PieceType::King:
+            targets = king_attacks(from);
+            break;
+        default:
+            break;
+    }
+    return test_bit(targets, to);
+}
+
+bool Position::is_legal(Move m) const noexcept {
+    const Color us = side_to_move_;
+    const Bitboard them = board_.occupied(opposite(us));
+    const Square from = m.from_sq;
+    const Square to = m.to_sq;
+    const Square ksq = board_.king_square(us);
+    const Bitboard occ = board_.occupied_all();
+
+    // Castling squares were checked for attacks by is_pseudo_legal.
+    if (m.flag == MoveFlag::CastleKingside || m.flag == MoveFlag::CastleQueenside)
+        return true;
+
+    // The king may not step onto an attacked square; lifting it off `from`
+    // uncovers squares behind it on a checking slider's line.
+    if (from == ksq)
+        return !(attackers_to(to, occ ^ square_bb(from)) & them);
+
+    if (m.flag == MoveFlag::EnPassant) {
+        // Two pawns leave the rank at once, so test the position after.
+        const Square captured = make_square(file_of(to), rank_of(from));
+        const Bitboard after = (occ ^ square_bb(from) ^ square_bb(captured)) | square_bb(to);
+        return !(attackers_to(ksq, after) & them & ~square_bb(captured));
+    }
+
+    // A pinned piece must stay on its pin line.
+    if (test_bit(pinned(), from) && !aligned(from, to, ksq))
+        return false;
+
+    // In check, the move has to capture the only checker or block it.
+    if (checkers_) {
+        if (more_than_one(checkers_))
+            return false;
+        const Square checker = lsb(checkers_);
+        return test_bit(between_bb(ksq, checker) | checkers_, to);
+    }
+    return true;
+}
+
+// ── Gives check ─────────────────────────────────────────────────────────────
+
+CheckInfo Position::check_info() const noexcept {
+    const Color us = side_to_move_;
+    const Color them = opposite(us);
+    const Bitboard occ = board_.occupied_all();
+    const Square ksq = board_.king_square(them);
+
+    CheckInfo ci;
+    ci.enemy_king = ksq;
+    const Bitboard diagonal = magic::bishop_attacks(ksq, occ);
+    const Bitboard straight = magic::rook_attacks(ksq, occ);
+    ci.check_squares[piece_index(PieceType::Pawn)] = pawn_attacks(them, ksq);
+    ci.check_squares[piece_index(PieceType::Knight)] = knight_attacks(ksq);
+    ci.check_squares[piece_index(PieceType::Bishop)] = diagonal;
+    ci.check_squares[piece_index(PieceType::Rook)] = straight;
+    ci.check_squares[piece_index(PieceType::Queen)] = diagonal | straight;
+
+    // Our pieces shielding their king from our own sliders.
+    ci.discoverers = blockers_for_king(them) & board_.occupied(us);
+    return ci;
+}
+
+bool Position::gives_check(Move m, const CheckInfo& ci) const noexcept {
+    const Color us = side_to_move_;
+    const Square from = m.from_sq;
+    const Square to = m.to_sq;
+    const Square ksq = ci.enemy_king;
+    const PieceType moved = board_.type_at(from);
+
+    // Direct check from the destination square.
+    if (m.flag != MoveFlag::Promotion && test_bit(ci.check_squares[piece_index(moved)], to)) {
+        return true;
+    }
+
+    // Discovered check: a shielding piece leaves the line to the king.
+    if (test_bit(ci.discoverers, from) && !aligned(from, to, ksq))
+        return true;
+
+    const Bitboard occ = board_.occupied_all();
+    switch (m.flag) {
+        case MoveFlag::Promotion: {
+            // The promoted piece may see the king through the square it
+            // just left, so its attacks use the post-move occupancy.
+            const Bitboard after = (occ ^ square_bb(from)) | square_bb(to);
+            switch (m.promotion) {
+                case PieceType::Knight:
+                    return test_bit(knight_attacks(to), ksq);
+                case PieceType::Bishop:
+                    return test_bit(magic::bishop_attacks(to, after), ksq);
+                case PieceType::Rook:
+                    return test_bit(magic::rook_attacks(to, after), ksq);
+                case PieceType::Queen:
+                    return test_bit(magic::queen_attacks(to, after), ksq);
+                default:
+                    return false;
+            }
+        }
+        case MoveFlag::EnPassant: {
+            // Removing the captured pawn can open a line as well.
+            const Square captured = make_square(file_of(to), rank_of(from));
+            const Bitboard after = (occ ^ square_bb(from) ^ square_bb(captured)) | square_bb(to);
+            const Bitboard queens = board_.pieces(us, PieceType::Queen);
+            return (magic::rook_attacks(ksq, after) &
+                    (board_.pieces(us, PieceType::Rook) | queens)) != 0 ||
+                   (magic::bishop_attacks(ksq, after) &
+                    (board_.pieces(us, PieceType::Bishop) | queens)) != 0;
+        }
+        case MoveFlag::CastleKingside:
+        case MoveFlag::CastleQueenside: {
+            // Only the rook can check; the king never gives check.
+            const int rank = rank_of(from);
+            const bool kingside = m.flag == MoveFlag::CastleKingside;
+            const Square rook_from = make_square(kingside ? 7 : 0, rank);
+            const Square rook_to = make_square(kingside ? 5 : 3, rank);
+            const Bitboard after =
+                (occ ^ square_bb(from) ^ square_bb(rook_from)) | square_bb(to) | square_bb(rook_to);
+            return test_bit(magic::rook_attacks(rook_to, after), ksq);
+        }
+        default:
+            return false;
+    }
+}
+
 // ── Null move ───────────────────────────────────────────────────────────────
 
 void Position::make_null_move() {
     // Save undo state (captured = kNoPiece since no move is made)
-    history_.push_back({castling_, en_passant_, halfmove_clock_, kNoPiece, key_});
+    history_.push_back({castling_, en_passant_, halfmove_clock_, kNoPiece, key_, checkers_,
+                        {blockers_for_king_[0], blockers_for_king_[1]}});
 
     // Clear en passant
     set_en_passant(kNoSquare);
 
-    // Flip side to move
+    // Flip side to move. Nothing moved, so the shields stand, and the side
+    // that passed was not giving check.
     side_to_move_ = opposite(side_to_move_);
     toggle_side_hash();
+    checkers_ = kEmptyBB;
 
     // Update clocks
     ++halfmove_clock_;
@@ -462,6 +727,7 @@ void Position::unmake_null_move() {
 
     // Restore castling (unchanged but for consistency)
     castling_ = undo.castling;
+    checkers_ = undo.checkers;
 
     // Flip side back
     side_to_move_ = opposite(side_to_move_);
@@ -485,6 +751,43 @@ int Position::repetition_count() const {
     return count;
 }
 
+// ── Draw rules ──────────────────────────────────────────────────────────────
+
+bool Position::is_insufficient_material() const noexcept {
+    Bitboard all = board_.occupied_all();
+    int total_pieces = popcount(all);
+
+    if (total_pieces == 2)
+        return true;  // K vs K
+
+    if (total_pieces == 3) {
+        // K+minor vs K
+        for (int c = 0; c < 2; ++c) {
+            auto color = static_cast<Color>(c);
+            if (board_.pieces(color, PieceType::Knight) ||
+                board_.pieces(color, PieceType::Bishop)) {
+                return true;
+            }
+        }
+    }
+
+    // K+B vs K+B on same color diagonals
+    if (total_pieces == 4) {
+        Bitboard wb = board_.pieces(Color::White, PieceType::Bishop);
+        Bitboard bb = board_.pieces(Color::Black, PieceType::Bishop);
+        if (wb && bb) {
+            // Light squares: (file + rank) even; dark squares: odd
+            constexpr Bitboard kLightSquares = 0x55AA55AA55AA55AAULL;
+            bool w_light = (wb & kLightSquares) != 0;
+            bool b_light = (bb & kLightSquares) != 0;
+            if (w_light == b_light)
+                return true;
+        }
+    }
+
+    return false;
+}
+
 // ── Private helpers ─────────────────────────────────────────────────────────
 
 void Position::compute_key() {
@@ -0,0 +1,184 @@
+/// @file san.cpp
+/// SAN formatting and parsing on top of legal move generation.
+
+#include <chessie/movegen.hpp>
+#include <chessie/san.hpp>
+
+#include <stdexcept>
+
+namespace chessie::san {
+
+namespace {
+
+constexpr char kPieceLetters[] = {' ', ' ', 'N', 'B', 'R', 'Q', 'K'};
+
+PieceType piece_from_letter(char c) noexcept {
+    switch (c) {
+        case 'N':
+            return PieceType::Knight;
+        case 'B':
+            return PieceType::Bishop;
+        case 'R':
+            return PieceType::Rook;
+        case 'Q':
+            return PieceType::Queen;
+        case 'K':
+            return PieceType::King;
+        default:
+            return PieceType::None;
+    }
+}
+
+bool is_castle(Move m) noexcept {
+    return m.flag == MoveFlag::CastleKingside || m.flag == MoveFlag::CastleQueenside;
+}
+
+[[noreturn]] void fail(std::string_view text, const char* why) {
+    throw std::invalid_argument(std::string(why) + " SAN move: '" + std::string(text) + "'");
+}
+
+}  // namespace
+
+// ── Formatting ──────────────────────────────────────────────────────────────
+
+std::string format(Position& pos, Move m) {
+    const Board& board = pos.board();
+    const PieceType piece = board.piece_at(m.from_sq).type;
+    MoveList legal = movegen::legal(pos);
+
+    std::string out;
+    if (m.flag == MoveFlag::CastleKingside) {
+        out = "O-O";
+    } else if (m.flag == MoveFlag::CastleQueenside) {
+        out = "O-O-O";
+    } else {
+        const bool capture =
+            board.piece_at(m.to_sq).type != PieceType::None || m.flag == MoveFlag::EnPassant;
+        if (piece == PieceType::Pawn) {
+            if (capture)
+                out += static_cast<char>('a' + file_of(m.from_sq));
+        } else {
+            out += kPieceLetters[static_cast<int>(piece)];
+
+            // Disambiguate against other pieces of the same type reaching `to`.
+            bool ambiguous = false;
+            bool same_file = false;
+            bool same_rank = false;
+            for (const Move& other : legal) {
+                if (other.to_sq != m.to_sq || other.from_sq == m.from_sq ||
+                    board.piece_at(other.from_sq).type != piece) {
+                    continue;
+                }
+                ambiguous = true;
+                same_file |= file_of(other.from_sq) == file_of(m.from_sq);
+                same_rank |= rank_of(other.from_sq) == rank_of(m.from_sq);
+            }
+            if (ambiguous) {
+                if (!same_file) {
+                    out += static_cast<char>('a' + file_of(m.from_sq));
+                } else if (!same_rank) {
+                    out += static_cast<char>('1' + rank_of(m.from_sq));
+                } else {
+                    out += square_name(m.from_sq);
+                }
+            }
+        }
+        if (capture)
+            out += 'x';
+        out += square_name(m.to_sq);
+        if (m.promotion != PieceType::None) {
+            out += '=';
+            out += kPieceLetters[static_cast<int>(m.promotion)];
+        }
+    }
+
+    pos.make_move(m);
+    if (pos.is_in_check()) {
+        out += movegen::legal(pos).empty() ? '#' : '+';
+    }
+    pos.unmake_move(m);
+    return out;
+}
+
+// ── Parsing ─────────────────────────────────────────────────────────────────
+
+Move parse(Position& pos, std::string_view text) {
+    std::string_view s = text;
+    while (!s.empty() && (s.back() == '+' || s.back() == '#' || s.back() == '!' ||
+                          s.back() == '?')) {
+        s.remove_suffix(1);
+    }
+    if (s.empty())
+        fail(text, "empty");
+
+    MoveList legal = movegen::legal(pos);
+
+    // Castling, with letter O or digit zero.
+    if (s == "O-O" || s == "0-0" || s == "O-O-O" || s == "0-0-0") {
+        const MoveFlag flag = s.size() == 3 ? MoveFlag::CastleKingside : MoveFlag::CastleQueenside;
+        for (const Move& m : legal) {
+            if (m.flag == flag)
+                return m;
+        }
+        fail(text, "illegal");
+    }
+
+    PieceType piece = piece_from_letter(s.front());
+    if (piece == PieceType::None) {
+        piece = PieceType::Pawn;
+    } else {
+        s.remove_prefix(1);
+    }
+
+    // Promotion suffix: "=Q" or a bare trailing piece letter.
+    PieceType promotion = PieceType::None;
+    if (!s.empty() && piece_from_letter(s.back()) != PieceType::None) {
+        promotion = piece_from_letter(s.back());
+        s.remove_suffix(1);
+        if (!s.empty() && s.back() == '=')
+            s.remove_suffix(1);
+    }
+
+    if (s.size() < 2)
+        fail(text, "malformed");
+    const Square to = parse_square(s.substr(s.size() - 2));
+    if (to == kNoSquare)
+        fail(text, "malformed");
+    s.remove_suffix(2);
+
+    // Whatever remains is an optional capture mark and disambiguation.
+    int from_file = -1;
+    int from_rank = -1;
+    for (char c : s) {
+        if (c >= 'a' && c <= 'h') {
+            from_file = c - 'a';
+        } else if (c >= '1' && c <= '8') {
+            from_rank = c - '1';
+        } else if (c != 'x' && c != ':' && c != '-') {
+            fail(text, "malformed");
+        }
+    }
+
+    const Board& board = pos.board();
+    Move found = kNullMove;
+    int matches = 0;
+    for (const Move& m : legal) {
+        if (m.to_sq != to || is_castle(m) || m.promotion != promotion ||
+            board.piece_at(m.from_sq).type != piece) {
+            continue;
+        }
+        if (from_file >= 0 && file_of(m.from_sq) != from_file)
+            continue;
+        if (from_rank >= 0 && rank_of(m.from_sq) != from_rank)
+            continue;
+        found = m;
+        ++matches;
+    }
+    if (matches == 0)
+        fail(text, "illegal");
+    if (matches > 1)
+        fail(text, "ambiguous");
+    return found;
+}
+
+}  // namespace chessie::san
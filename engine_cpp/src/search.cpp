@@ -2,10 +2,13 @@
 /// Alpha-beta search with iterative deepening and all pruning techniques.
 
 #include <chessie/search.hpp>
+#include <chessie/trace.hpp>
 
 #include <algorithm>
 #include <cmath>
+#include <cstdlib>
 #include <cstring>
+#include <utility>
 
 namespace chessie {
 
@@ -15,11 +18,24 @@ namespace {
 
 constexpr int kNullMoveMinDepth = 3;
 constexpr int kNullMoveBaseReduction = 2;
+constexpr int kNullMoveEvalDivisor = 200;  // centipawns above beta per extra ply
+constexpr int kNullMoveMaxEvalReduction = 3;
+constexpr int kNullMoveVerifyDepth = 8;
 constexpr int kLmrMinDepth = 4;
 constexpr int kLmrMinMoveIndex = 3;
 constexpr int kQuiescenceMaxDepth = 16;
 constexpr int kFutilityMargin = 200;         // centipawns
 constexpr int kReverseFutilityMargin = 300;  // centipawns
+constexpr int kImprovingMargin = 100;        // centipawns
+constexpr int kRazoringMaxDepth = 2;
+constexpr int kRazoringMargin = 350;  // centipawns per ply
+constexpr int kProbCutMinDepth = 5;
+constexpr int kProbCutReduction = 4;
+constexpr int kProbCutMargin = 200;  // centipawns
+
+// TT depths of quiescence entries; below every main-search depth
+constexpr int kQsDepthInCheck = 0;
+constexpr int kQsDepthNoCheck = -1;
 
 // Killer move bonuses
 constexpr int kKillerPrimaryBonus = 9'000;
@@ -28,8 +44,8 @@ constexpr int kKillerSecondaryBonus = 8'000;
 // History heuristic
 constexpr int kHistoryMax = 8'000;
 
-// Check for time every N nodes
-constexpr std::uint64_t kTimeCheckInterval = 4096;
+// How often the watchdog polls an external stop flag
+constexpr auto kStopFlagPollInterval = std::chrono::milliseconds(1);
 
 // ── MVV-LVA values ──────────────────────────────────────────────────────────
 // Indexed by piece_index(): Pawn=0..King=5
@@ -38,11 +54,14 @@ constexpr int kMvvValues[] = {100, 320, 330, 500, 900, 0};
 
 // ── LMR reduction table ─────────────────────────────────────────────────────
 
-int lmr_reduction(int depth, int move_index) {
+int lmr_reduction(int depth, int move_index, bool improving) {
     int r = 1;
     if (depth >= 8 && move_index >= 8) {
         r += 1;
     }
+    if (!improving && move_index >= 6) {
+        r += 1;
+    }
     return r;
 }
 
@@ -50,138 +69,210 @@ int lmr_reduction(int depth, int move_index) {
 
 // ── Search construction ─────────────────────────────────────────────────────
 
-Search::Search(std::size_t tt_mb) : tt_(tt_mb) {}
+Search::Search(std::size_t tt_mb) : tt_(std::make_shared<TranspositionTable>(tt_mb)) {}
+
+Search::Search(std::shared_ptr<TranspositionTable> tt) : tt_(std::move(tt)) {}
+
+Search::~Search() {
+    if (watchdog_.joinable()) {
+        {
+            std::lock_guard lock(watchdog_mutex_);
+            watchdog_exit_ = true;
+        }
+        watchdog_cv_.notify_one();
+        watchdog_.join();
+    }
+}
 
 // ── Reset heuristics ────────────────────────────────────────────────────────
 
 void Search::reset_heuristics() {
-    std::memset(killers_, 0, sizeof(killers_));
+    for (SearchStack& ss : stack_) ss = SearchStack{};
     std::memset(history_, 0, sizeof(history_));
 }
 
+void Search::age_heuristics(int plies) {
+    // Ply p of the new search corresponds to ply p + plies of the old one.
+    for (int p = 0; p < kMaxPly; ++p) {
+        const int from = p + plies;
+        stack_[p].killers[0] = from < kMaxPly ? stack_[from].killers[0] : kNullMove;
+        stack_[p].killers[1] = from < kMaxPly ? stack_[from].killers[1] : kNullMove;
+    }
+    for (auto& side : history_) {
+        for (auto& row : side) {
+            for (int& h : row) h /= 2;
+        }
+    }
+}
+
+void Search::prepare_heuristics(const Position& root) {
+    const int root_ply = 2 * (root.fullmove_number() - 1) +
+                         (root.side_to_move() == Color::Black ? 1 : 0);
+    const int plies = root_ply - last_root_ply_;
+    if (heuristic_reuse_ == HeuristicReuse::Age && last_root_ply_ >= 0 && plies >= 0 &&
+        plies < kMaxPly) {
+        age_heuristics(plies);
+    } else {
+        reset_heuristics();
+    }
+    last_root_ply_ = root_ply;
+}
+
 // ── Main search entry point ─────────────────────────────────────────────────
 
 SearchResult Search::search(Position& pos, const SearchLimits& limits) {
+    CHESSIE_TRACE_SCOPE("search");
     cancelled_.store(false, std::memory_order_relaxed);
     nodes_ = 0;
-    reset_heuristics();
-    tt_.new_search();
+    seldepth_ = 0;
+    stats_ = {};
+    params_ = eval::params();
+    prepare_heuristics(pos);
+    tt_->new_search();
 
     // Set deadline
+    start_ = std::chrono::steady_clock::now();
+    node_limit_ = limits.max_nodes != 0 ? limits.max_nodes : ~std::uint64_t{0};
+    stop_flag_ = limits.stop_flag;
     has_deadline_ = (limits.time_limit_ms > 0);
     if (has_deadline_) {
-        deadline_ =
-            std::chrono::steady_clock::now() + std::chrono::milliseconds(limits.time_limit_ms);
+        deadline_ = start_ + std::chrono::milliseconds(limits.time_limit_ms);
     }
 
     // Generate root legal moves
-    MoveList root_moves = movegen::legal(pos);
-    if (root_moves.empty()) {
+    MoveList legal = movegen::legal(pos);
+    root_moves_.clear();
+    if (legal.empty()) {
         // Checkmate or stalemate
         if (pos.is_in_check()) {
-            return {kNullMove, -kMateScore, 0, nodes_};
+            return make_result(kNullMove, -kMateScore, 0);
         }
-        return {kNullMove, 0, 0, nodes_};
+        return make_result(kNullMove, 0, 0);
     }
 
     // Order root moves with current heuristics
-    order_moves(pos, root_moves, kNullMove, 0);
+    order_moves(pos, legal, kNullMove, 0);
+    for (const Move& m : legal) root_moves_.emplace_back(m);
+    stack_[0].static_eval =
+        pos.is_in_check() ? SearchStack::kNoEval : eval::evaluate(pos, *params_);
+    arm_watchdog();
 
-    Move best_move = root_moves[0];
+    Move best_move = root_moves_.front().move;
     int best_score = -kInfScore;
     int completed_depth = 0;
+    std::uint64_t prev_iter_nodes = 0;
 
     // Iterative deepening
     for (int depth = 1; depth <= limits.max_depth; ++depth) {
         if (should_stop())
             break;
 
-        int score = -kInfScore;
-        Move iter_best = kNullMove;
+        const std::uint64_t nodes_before = nodes_;
+        CHESSIE_TRACE_SPAN(iteration_span, "iteration", depth);
+
         int alpha = -kInfScore;
         int beta = kInfScore;
+        for (RootMove& rm : root_moves_) {
+            rm.previous_score = rm.score;
+            rm.score = -kInfScore;
+        }
 
-        for (int i = 0; i < root_moves.size(); ++i) {
+        for (std::size_t i = 0; i < root_moves_.size(); ++i) {
             if (should_stop())
                 break;
 
-            Move m = root_moves[i];
-            pos.make_move(m);
+            RootMove& rm = root_moves_[i];
+            CHESSIE_TRACE_SPAN(root_span, "root_move", static_cast<int>(i));
+            CHESSIE_TRACE_DETAIL(root_span, rm.move.uci());
+            const std::uint64_t move_nodes_before = nodes_;
+            stack_[0].current_move = rm.move;
+            pos.make_move(rm.move);
             int s = -negamax(pos, depth - 1, -beta, -alpha, 1, true);
-            pos.unmake_move(m);
+            pos.unmake_move(rm.move);
+            rm.nodes += nodes_ - move_nodes_before;
 
-            if (s > score) {
-                score = s;
-                iter_best = m;
-            }
+            // Only a move that raises alpha has an exact score; the rest
+            // keep -kInfScore and are ordered by their previous score.
             if (s > alpha) {
                 alpha = s;
+                rm.score = s;
             }
         }
 
-        if (should_stop())
+        if (should_stop()) {
+            // The interrupted iteration's scores are incomplete.
+            for (RootMove& rm : root_moves_) rm.score = rm.previous_score;
             break;
-        if (iter_best.is_null())
+        }
+        if (alpha == -kInfScore)
             break;
 
-        best_move = iter_best;
-        best_score = score;
+        sort_root_moves();
+        extract_pv(pos, root_moves_.front());
+        best_move = root_moves_.front().move;
+        best_score = root_moves_.front().score;
         completed_depth = depth;
 
-        // Move best move to front for next iteration
-        for (int i = 0; i < root_moves.size(); ++i) {
-            if (root_moves[i] == best_move) {
-                // Shift moves to make best_move first
-                Move tmp = root_moves[i];
-                for (int j = i; j > 0; --j) {
-                    root_moves[j] = root_moves[j - 1];
-                }
-                root_moves[0] = tmp;
-                break;
-            }
-        }
+        const std::uint64_t iter_nodes = nodes_ - nodes_before;
+        const double ebf = prev_iter_nodes == 0 ? 0.0
+                                                : static_cast<double>(iter_nodes) /
+                                                      static_cast<double>(prev_iter_nodes);
+        IterationStats iteration = iteration_stats(depth, iter_nodes, ebf);
+        iteration.best_move = best_move;
+        iteration.score = best_score;
+        iteration.best_move_node_fraction =
+            static_cast<double>(root_moves_.front().nodes) / static_cast<double>(nodes_);
+        stats_.iterations.push_back(iteration);
+        prev_iter_nodes = iter_nodes;
     }
 
-    return {best_move, best_score, completed_depth, nodes_};
+    disarm_watchdog();
+    return make_result(best_move, best_score, completed_depth);
 }
 
 // ── Negamax with alpha-beta ─────────────────────────────────────────────────
 
 int Search::negamax(Position& pos, int depth, int alpha, int beta, int ply, bool allow_null) {
     if (should_stop())
-        return eval::evaluate(pos);
+        return eval::evaluate(pos, *params_);
 
     ++nodes_;
+    seldepth_ = std::max(seldepth_, ply);
 
     // ── Draw detection ──────────────────────────────────────────────────
     if (is_draw(pos))
         return 0;
+    if (ply >= kMaxPly - 1)
+        return eval::evaluate(pos, *params_);
+
+    SearchStack& ss = stack_[ply];
 
     // ── Transposition table probe ───────────────────────────────────────
     int alpha_orig = alpha;
     TTEntry tt_entry{};
     Move tt_move = kNullMove;
-    bool tt_hit = tt_.probe(pos.key(), tt_entry);
+    bool tt_hit = tt_->probe(pos.key(), tt_entry);
+    const int tt_score = tt_hit ? score_from_tt(tt_entry.score, ply) : 0;
+    count(&SearchStats::tt_probes);
 
     if (tt_hit) {
+        count(&SearchStats::tt_hits);
         tt_move = tt_entry.best_move;
         if (tt_entry.depth >= depth) {
-            int tt_score = tt_entry.score;
-
-            // Mate score adjustment: convert from stored (relative to root) to current ply
+            // Mate scores are read back relative to this ply (score_from_tt)
             if (tt_score > kMateScore - kMaxPly) {
                 // Don't use mate scores from TT at PV nodes to avoid instability
             } else if (tt_score < -kMateScore + kMaxPly) {
                 // Same for negative mate scores
             } else {
-                if (tt_entry.bound == Bound::Exact)
-                    return tt_score;
                 if (tt_entry.bound == Bound::Lower)
                     alpha = std::max(alpha, tt_score);
                 if (tt_entry.bound == Bound::Upper)
                     beta = std::min(beta, tt_score);
-                if (alpha >= beta)
+                if (tt_entry.bound == Bound::Exact || alpha >= beta) {
+                    count(&SearchStats::tt_cutoffs);
                     return tt_score;
+                }
             }
         }
     }
@@ -191,7 +282,14 @@ int Search::negamax(Position& pos, int depth, int alpha, int beta, int ply, bool
         return quiescence(pos, alpha, beta, ply, 0);
     }
 
-    bool in_check = pos.is_in_check();
+    // ── Static eval ─────────────────────────────────────────────────────
+    // Every eval-based pruning below is off in check, so in-check nodes skip
+    // the attack map and the evaluation.
+    const Color us = pos.side_to_move();
+    const bool in_check = pos.is_in_check();
+    const int static_eval = in_check ? 0 : eval::evaluate(pos, *params_);
+    ss.static_eval = in_check ? SearchStack::kNoEval : static_eval;
+    const bool improving = is_improving(ply);
 
     // ── Check extension ─────────────────────────────────────────────────
     if (in_check) {
@@ -199,82 +297,249 @@ int Search::negamax(Position& pos, int depth, int alpha, int beta, int ply, bool
     }
 
     // ── Reverse futility pruning (static eval pruning) ──────────────────
+    // A rising eval is trusted with a narrower margin.
     if (!in_check && depth <= 3 && ply > 0) {
-        int static_eval = eval::evaluate(pos);
-        if (static_eval - kReverseFutilityMargin * depth >= beta) {
+        const int margin = kReverseFutilityMargin * depth - (improving ? kImprovingMargin : 0);
+        if (static_eval - margin >= beta) {
+            count(&SearchStats::reverse_futility_prunes);
             return static_eval;
         }
     }
 
+    // ── Razoring ────────────────────────────────────────────────────────
+    // Far below alpha near the horizon only captures can recover; let
+    // quiescence decide and trust it when it agrees.
+    if (!in_check && depth <= kRazoringMaxDepth && ply > 0 &&
+        static_eval + kRazoringMargin * depth <= alpha) {
+        const int score = quiescence(pos, alpha - 1, alpha, ply, 0);
+        if (score < alpha) {
+            count(&SearchStats::razor_prunes);
+            return score;
+        }
+    }
+
     // ── Null move pruning ───────────────────────────────────────────────
-    if (allow_null && !in_check && depth >= kNullMoveMinDepth && ply > 0 &&
-        has_non_pawn_material(pos, pos.side_to_move())) {
-        int reduction = kNullMoveBaseReduction + depth / 4;
+    // Skipped when the TT already says the node fails low. The further the
+    // eval sits above beta, the harder the null search is reduced.
+    const bool tt_fails_low = tt_hit && tt_entry.bound == Bound::Upper && tt_score < beta;
+    if (allow_null && !in_check && !tt_fails_low && depth >= kNullMoveMinDepth && ply > 0 &&
+        static_eval >= beta && has_non_pawn_material(pos, us)) {
+        const int eval_reduction =
+            std::min((static_eval - beta) / kNullMoveEvalDivisor, kNullMoveMaxEvalReduction);
+        int reduction = kNullMoveBaseReduction + depth / 4 + eval_reduction;
         int null_depth = std::max(0, depth - 1 - reduction);
 
+        count(&SearchStats::null_tries);
+        ss.current_move = kNullMove;
         pos.make_null_move();
         int null_score = -negamax(pos, null_depth, -beta, -beta + 1, ply + 1, false);
         pos.unmake_null_move();
 
         if (should_stop())
-            return eval::evaluate(pos);
-        if (null_score >= beta)
-            return beta;
+            return static_eval;
+        if (null_score >= beta) {
+            // Deep cutoffs are verified by a reduced search without the null
+            // move, which catches zugzwang positions where passing is best.
+            bool confirmed = true;
+            if (depth >= kNullMoveVerifyDepth) {
+                confirmed = negamax(pos, null_depth, beta - 1, beta, ply, false) >= beta;
+                if (should_stop())
+                    return static_eval;
+            }
+            if (confirmed) {
+                count(&SearchStats::null_cutoffs);
+                return beta;
+            }
+        }
     }
 
-    // ── Generate legal moves ────────────────────────────────────────────
-    MoveList moves = movegen::legal(pos);
+    // ── ProbCut ─────────────────────────────────────────────────────────
+    // A capture that beats beta by a margin in a reduced search will almost
+    // surely beat beta at full depth. Skipped when the TT already says the
+    // reduced search would fail.
+    const int probcut_beta = beta + kProbCutMargin;
+    if (!in_check && depth >= kProbCutMinDepth && ply > 0 &&
+        std::abs(beta) < kMateScore - kMaxPly &&
+        !(tt_hit && tt_entry.depth >= depth - kProbCutReduction + 1 &&
+          tt_score < probcut_beta)) {
+        const MoveList captures = movegen::captures(pos);
+        for (int i = 0; i < captures.size(); ++i) {
+            const Move m = captures[i];
+            // Only captures whose material gain can bridge the margin.
+            const Piece victim = pos.board().piece_at(m.to_sq);
+            int gain = m.flag == MoveFlag::EnPassant ? kMvvValues[0]
+                       : victim.type != PieceType::None ? kMvvValues[piece_index(victim.type)]
+                                                        : 0;
+            if (m.flag == MoveFlag::Promotion)
+                gain += kMvvValues[piece_index(m.promotion)] - kMvvValues[0];
+            if (static_eval + gain < probcut_beta)
+                continue;
+
+            if (!pos.is_legal(m))
+                continue;
+            ss.current_move = m;
+            pos.make_move(m);
+            // Confirm with quiescence before paying for the reduced search.
+            int score = -quiescence(pos, -probcut_beta, -probcut_beta + 1, ply + 1, 0);
+            if (score >= probcut_beta) {
+                score = -negamax(pos, depth - kProbCutReduction, -probcut_beta,
+                                 -probcut_beta + 1, ply + 1, true);
+            }
+            pos.unmake_move(m);
 
-    if (moves.empty()) {
-        if (in_check)
-            return -kMateScore + ply;
-        return 0;  // stalemate
+            if (should_stop())
+                return static_eval;
+            if (score >= probcut_beta) {
+                count(&SearchStats::probcut_prunes);
+                tt_->store(pos.key(), depth - kProbCutReduction + 1, score_to_tt(score, ply),
+                           Bound::Lower, m, static_eval);
+                return score;
+            }
+        }
     }
 
-    // ── Move ordering ───────────────────────────────────────────────────
-    order_moves(pos, moves, tt_move, ply);
+    // ── Hash move ───────────────────────────────────────────────────────
+    // A TT move that is still pseudo-legal and legal here is searched before
+    // anything is generated; when it refutes the node, generation is skipped
+    // entirely. Key collisions hand back moves from other positions, which
+    // the validation rejects.
+    const Move hash_move = !tt_move.is_null() && pos.is_pseudo_legal(tt_move) &&
+                                   pos.is_legal(tt_move)
+                               ? tt_move
+                               : kNullMove;
+
+    // ── Staged move picking ─────────────────────────────────────────────
+    // Hash move, then captures and promotions, then the remaining quiet
+    // moves. The killers are validated like the hash move and slotted in
+    // among the captures by the scores the full ordering gives them, so a
+    // killer cutoff never pays for quiet generation or ordering.
+    enum class Stage { Hash, GenerateCaptures, Captures, Killers, Quiets, Done };
+    Stage stage = Stage::Hash;
+    MoveList moves;
+    int next = 0;
+    Move killers[2] = {kNullMove, kNullMove};  // playable killers, best first
+    int killer_scores[2] = {0, 0};
+    int killer_count = 0;
+    int next_killer = 0;
+    auto is_noisy = [&](Move m) {
+        return !pos.board().is_empty(m.to_sq) || m.flag == MoveFlag::EnPassant ||
+               m.flag == MoveFlag::Promotion;
+    };
+    // Next legal move of the current list, or the null move when it runs out.
+    auto pick = [&]() -> Move {
+        while (next < moves.size()) {
+            const Move m = moves[next++];
+            if (m == hash_move || m == killers[0] || m == killers[1])
+                continue;
+            if (stage == Stage::Quiets && is_noisy(m))
+                continue;
+            if (!pos.is_legal(m))
+                continue;
+            return m;
+        }
+        return kNullMove;
+    };
+    // Next legal move to search, or the null move when exhausted.
+    auto next_move = [&]() -> Move {
+        switch (stage) {
+            case Stage::Hash:
+                stage = Stage::GenerateCaptures;
+                if (!hash_move.is_null())
+                    return hash_move;
+                [[fallthrough]];
+            case Stage::GenerateCaptures:
+                stage = Stage::Captures;
+                moves = movegen::captures(pos);
+                order_moves(pos, moves, tt_move, ply);
+                for (const Move k : ss.killers) {
+                    if (k.is_null() || k == hash_move || is_noisy(k) ||
+                        !pos.is_pseudo_legal(k) || !pos.is_legal(k))
+                        continue;
+                    killers[killer_count] = k;
+                    killer_scores[killer_count++] = move_score(pos, k, tt_move, ply);
+                }
+                if (killer_count == 2 && killer_scores[1] > killer_scores[0]) {
+                    std::swap(killers[0], killers[1]);
+                    std::swap(killer_scores[0], killer_scores[1]);
+                }
+                [[fallthrough]];
+            case Stage::Captures:
+                if (const Move m = pick(); !m.is_null()) {
+                    if (next_killer < killer_count &&
+                        killer_scores[next_killer] > move_score(pos, m, tt_move, ply)) {
+                        --next;  // the capture comes back on the next call
+                        return killers[next_killer++];
+                    }
+                    return m;
+                }
+                stage = Stage::Killers;
+                [[fallthrough]];
+            case Stage::Killers:
+                if (next_killer < killer_count)
+                    return killers[next_killer++];
+                stage = Stage::Quiets;
+                moves = movegen::pseudo_legal(pos);
+                order_moves(pos, moves, tt_move, ply);
+                next = 0;
+                [[fallthrough]];
+            case Stage::Quiets:
+                if (const Move m = pick(); !m.is_null())
+                    return m;
+                stage = Stage::Done;
+                [[fallthrough]];
+            case Stage::Done:
+                break;
+        }
+        return kNullMove;
+    };
+
+    const CheckInfo check_info = pos.check_info();
 
     int best_score = -kInfScore;
     Move best_move = kNullMove;
-    Color side_to_move = pos.side_to_move();
 
     // ── Futility pruning flag ───────────────────────────────────────────
+    // Quiet moves keep a wider margin while the eval is rising.
     bool can_futility = false;
     int futility_base = 0;
     if (!in_check && depth <= 2 && ply > 0) {
-        futility_base = eval::evaluate(pos) + kFutilityMargin * depth;
+        futility_base = static_eval + kFutilityMargin * depth + (improving ? kImprovingMargin : 0);
         can_futility = (futility_base <= alpha);
     }
 
-    for (int i = 0; i < moves.size(); ++i) {
-        Move m = moves[i];
-
+    int i = 0;
+    for (Move m = next_move(); !m.is_null(); m = next_move(), ++i) {
         // Is this a quiet (non-capture, non-promotion) move?
-        bool is_capture = (pos.board().piece_at(m.to_sq).type != PieceType::None);
+        bool is_capture = !pos.board().is_empty(m.to_sq);
         bool is_ep = (m.flag == MoveFlag::EnPassant);
         bool is_promo = (m.flag == MoveFlag::Promotion);
         bool is_quiet = !is_capture && !is_ep && !is_promo;
+        const bool gives_check = pos.gives_check(m, check_info);
 
         // ── Futility pruning: skip quiet moves that won't beat alpha ────
-        if (can_futility && is_quiet && i > 0 && best_score > -kMateScore + kMaxPly) {
+        if (can_futility && is_quiet && !gives_check && i > 0 &&
+            best_score > -kMateScore + kMaxPly) {
+            count(&SearchStats::futility_prunes);
             continue;
         }
 
         // ── LMR conditions ──────────────────────────────────────────────
-        bool can_lmr = is_quiet && !in_check && depth >= kLmrMinDepth && i >= kLmrMinMoveIndex &&
-                       (tt_move.is_null() || m != tt_move);
+        bool can_lmr = is_quiet && !in_check && !gives_check && depth >= kLmrMinDepth &&
+                       i >= kLmrMinMoveIndex && (tt_move.is_null() || m != tt_move);
 
+        ss.current_move = m;
         pos.make_move(m);
 
         int score;
-        if (can_lmr && !pos.is_in_check()) {
+        if (can_lmr) {
             // Late Move Reduction: search with reduced depth
-            int r = lmr_reduction(depth, i);
+            int r = lmr_reduction(depth, i, improving);
             int reduced_depth = std::max(0, depth - 1 - r);
             score = -negamax(pos, reduced_depth, -alpha - 1, -alpha, ply + 1, true);
 
             // Re-search at full depth if LMR failed high
             if (score > alpha) {
+                count(&SearchStats::lmr_researches);
                 score = -negamax(pos, depth - 1, -beta, -alpha, ply + 1, true);
             }
         } else {
@@ -291,10 +556,13 @@ int Search::negamax(Position& pos, int depth, int alpha, int beta, int ply, bool
             alpha = score;
         }
         if (alpha >= beta) {
+            count(&SearchStats::beta_cutoffs);
+            if (i == 0)
+                count(&SearchStats::first_move_cutoffs);
             // Beta cutoff — record killer and history for quiet moves
             if (is_quiet) {
                 record_killer(m, ply);
-                update_history(side_to_move, m, depth);
+                update_history(us, m, depth);
             }
             break;
         }
@@ -303,7 +571,10 @@ int Search::negamax(Position& pos, int depth, int alpha, int beta, int ply, bool
     }
 
     if (best_score == -kInfScore) {
-        return eval::evaluate(pos);
+        // No legal move at all: checkmate or stalemate.
+        if (i == 0)
+            return in_check ? -kMateScore + ply : 0;
+        return in_check ? alpha : static_eval;
     }
 
     // ── Store in TT ─────────────────────────────────────────────────────
@@ -313,8 +584,7 @@ int Search::negamax(Position& pos, int depth, int alpha, int beta, int ply, bool
     } else if (best_score >= beta) {
         bound = Bound::Lower;
     }
-    int static_eval_for_tt = eval::evaluate(pos);
-    tt_.store(pos.key(), depth, best_score, bound, best_move, static_eval_for_tt);
+    tt_->store(pos.key(), depth, score_to_tt(best_score, ply), bound, best_move, static_eval);
 
     return best_score;
 }
@@ -323,15 +593,39 @@ int Search::negamax(Position& pos, int depth, int alpha, int beta, int ply, bool
 
 int Search::quiescence(Position& pos, int alpha, int beta, int ply, int q_depth) {
     if (should_stop())
-        return eval::evaluate(pos);
+        return eval::evaluate(pos, *params_);
 
     ++nodes_;
+    seldepth_ = std::max(seldepth_, ply);
+    count(&SearchStats::qnodes);
 
     if (is_draw(pos))
         return 0;
 
     bool in_check = pos.is_in_check();
 
+    // ── Transposition table probe ───────────────────────────────────────
+    // Every quiescence entry is usable here: in-check nodes store depth 0,
+    // the rest depth -1, and main-search entries are deeper still.
+    const int tt_depth = in_check ? kQsDepthInCheck : kQsDepthNoCheck;
+    const int alpha_orig = alpha;
+    TTEntry tt_entry{};
+    Move tt_move = kNullMove;
+    count(&SearchStats::tt_probes);
+    if (tt_->probe(pos.key(), tt_entry)) {
+        count(&SearchStats::tt_hits);
+        tt_move = tt_entry.best_move;
+        const int tt_score = score_from_tt(tt_entry.score, ply);
+        const bool is_mate = tt_score > kMateScore - kMaxPly || tt_score < -kMateScore + kMaxPly;
+        if (tt_entry.depth >= tt_depth && !is_mate &&
+            (tt_entry.bound == Bound::Exact ||
+             (tt_entry.bound == Bound::Lower && tt_score >= beta) ||
+             (tt_entry.bound == Bound::Upper && tt_score <= alpha))) {
+            count(&SearchStats::tt_cutoffs);
+            return tt_score;
+        }
+    }
+
     // In check: search all legal moves (no stand-pat)
     if (in_check) {
         MoveList moves = movegen::legal(pos);
@@ -339,19 +633,22 @@ int Search::quiescence(Position& pos, int alpha, int beta, int ply, int q_depth)
             return -kMateScore + ply;
 
         if (q_depth >= kQuiescenceMaxDepth) {
-            return eval::evaluate(pos);
+            return eval::evaluate(pos, *params_);
         }
 
-        order_moves(pos, moves, kNullMove, ply);
+        order_moves(pos, moves, tt_move, ply);
 
         int best_score = -kInfScore;
+        Move best_move = kNullMove;
         for (int i = 0; i < moves.size(); ++i) {
             pos.make_move(moves[i]);
             int score = -quiescence(pos, -beta, -alpha, ply + 1, q_depth + 1);
             pos.unmake_move(moves[i]);
 
-            if (score > best_score)
+            if (score > best_score) {
                 best_score = score;
+                best_move = moves[i];
+            }
             if (score > alpha)
                 alpha = score;
             if (alpha >= beta)
@@ -359,18 +656,29 @@ int Search::quiescence(Position& pos, int alpha, int beta, int ply, int q_depth)
             if (should_stop())
                 break;
         }
+        if (!should_stop()) {
+            const Bound bound = best_score >= beta          ? Bound::Lower
+                                : best_score <= alpha_orig ? Bound::Upper
+                                                           : Bound::Exact;
+            tt_->store(pos.key(), tt_depth, score_to_tt(best_score, ply), bound, best_move, 0);
+        }
         return best_score;
     }
 
-    // Stand-pat
-    int stand_pat = eval::evaluate(pos);
+    // Stand-pat. Most quiescence nodes are decided by material alone, so
+    // the lazy evaluation skips the attack terms far from the window.
+    int stand_pat =
+        eval::evaluate(pos, *params_, alpha, beta, kSearchStats ? &stats_.eval : nullptr);
 
     if (q_depth >= kQuiescenceMaxDepth) {
         return stand_pat;
     }
 
-    if (stand_pat >= beta)
+    if (stand_pat >= beta) {
+        tt_->store(pos.key(), tt_depth, score_to_tt(beta, ply), Bound::Lower, kNullMove,
+                   stand_pat);
         return beta;
+    }
     if (stand_pat > alpha)
         alpha = stand_pat;
 
@@ -379,33 +687,38 @@ int Search::quiescence(Position& pos, int alpha, int beta, int ply, int q_depth)
 
     // Filter to legal moves
     MoveList legal_noisy;
-    Color us = pos.side_to_move();
     for (int i = 0; i < noisy.size(); ++i) {
-        pos.make_move(noisy[i]);
-        if (!pos.is_in_check(us)) {
+        if (pos.is_legal(noisy[i]))
             legal_noisy.push(noisy[i]);
-        }
-        pos.unmake_move(noisy[i]);
     }
 
-    if (legal_noisy.empty())
-        return alpha;
-
-    order_moves(pos, legal_noisy, kNullMove, ply);
+    // The TT move goes first when it is one of the captures.
+    order_moves(pos, legal_noisy, tt_move, ply);
 
+    Move best_move = kNullMove;
     for (int i = 0; i < legal_noisy.size(); ++i) {
         pos.make_move(legal_noisy[i]);
         int score = -quiescence(pos, -beta, -alpha, ply + 1, q_depth + 1);
         pos.unmake_move(legal_noisy[i]);
 
-        if (score >= beta)
+        if (score >= beta) {
+            if (!should_stop())
+                tt_->store(pos.key(), tt_depth, score_to_tt(beta, ply), Bound::Lower,
+                           legal_noisy[i], stand_pat);
             return beta;
-        if (score > alpha)
+        }
+        if (score > alpha) {
             alpha = score;
+            best_move = legal_noisy[i];
+        }
         if (should_stop())
             break;
     }
 
+    if (!should_stop()) {
+        tt_->store(pos.key(), tt_depth, score_to_tt(alpha, ply),
+                   alpha > alpha_orig ? Bound::Exact : Bound::Upper, best_move, stand_pat);
+    }
     return alpha;
 }
 
@@ -460,9 +773,9 @@ int Search::move_score(const Position& pos, Move m, Move tt_move, int ply) const
     } else {
         // Quiet move: killer + history
         if (ply < kMaxPly) {
-            if (killers_[ply][0] == m) {
+            if (stack_[ply].killers[0] == m) {
                 score += kKillerPrimaryBonus;
-            } else if (killers_[ply][1] == m) {
+            } else if (stack_[ply].killers[1] == m) {
                 score += kKillerSecondaryBonus;
             }
         }
@@ -484,10 +797,28 @@ int Search::move_score(const Position& pos, Move m, Move tt_move, int ply) const
 void Search::record_killer(Move m, int ply) {
     if (ply < 0 || ply >= kMaxPly)
         return;
-    if (killers_[ply][0] == m)
+    Move* killers = stack_[ply].killers;
+    if (killers[0] == m)
         return;
-    killers_[ply][1] = killers_[ply][0];
-    killers_[ply][0] = m;
+    killers[1] = killers[0];
+    killers[0] = m;
+}
+
+// ── Improving ───────────────────────────────────────────────────────────────
+
+bool Search::is_improving(int ply) const noexcept {
+    // Compare with the last ancestor of the same side that was not in check,
+    // two or four plies back. Without one, assume improving so the node is
+    // pruned no harder than before.
+    const int eval = stack_[ply].static_eval;
+    if (eval == SearchStack::kNoEval)
+        return false;
+    for (int back = 2; back <= 4 && ply - back >= 0; back += 2) {
+        const int before = stack_[ply - back].static_eval;
+        if (before != SearchStack::kNoEval)
+            return eval > before;
+    }
+    return true;
 }
 
 // ── History heuristic ───────────────────────────────────────────────────────
@@ -499,16 +830,121 @@ void Search::update_history(Color side, Move m, int depth) {
         h = kHistoryMax;
 }
 
+// ── Result reporting ────────────────────────────────────────────────────────
+
+std::int64_t Search::elapsed_us() const {
+    return std::chrono::duration_cast<std::chrono::microseconds>(std::chrono::steady_clock::now() -
+                                                                 start_)
+        .count();
+}
+
+IterationStats Search::iteration_stats(int depth, std::uint64_t iter_nodes, double ebf) const {
+    const std::int64_t us = std::max<std::int64_t>(elapsed_us(), 1);
+    IterationStats it;
+    it.depth = depth;
+    it.seldepth = seldepth_;
+    it.nodes = iter_nodes;
+    it.ebf = ebf;
+    it.time_ms = us / 1000;
+    it.nps = nodes_ * 1'000'000 / static_cast<std::uint64_t>(us);
+    it.hashfull = tt_->hashfull();
+    return it;
+}
+
+// ── Root moves ──────────────────────────────────────────────────────────────
+
+void Search::sort_root_moves() {
+    // Stable, so moves that failed low in both iterations keep their order.
+    std::stable_sort(root_moves_.begin(), root_moves_.end(),
+                     [](const RootMove& a, const RootMove& b) {
+                         return a.score != b.score ? a.score > b.score
+                                                   : a.previous_score > b.previous_score;
+                     });
+}
+
+void Search::extract_pv(Position& pos, RootMove& rm) {
+    // Follow TT moves from the root move while they are legal; the line ends
+    // at the first miss or repetition.
+    rm.pv.assign(1, rm.move);
+    pos.make_move(rm.move);
+    TTEntry entry{};
+    while (rm.pv.size() < static_cast<std::size_t>(kMaxPly) && !is_draw(pos) &&
+           tt_->probe(pos.key(), entry) && !entry.best_move.is_null()) {
+        const MoveList legal = movegen::legal(pos);
+        if (std::find(legal.begin(), legal.end(), entry.best_move) == legal.end())
+            break;
+        rm.pv.push_back(entry.best_move);
+        pos.make_move(entry.best_move);
+    }
+    for (auto it = rm.pv.rbegin(); it != rm.pv.rend(); ++it) pos.unmake_move(*it);
+}
+
+SearchResult Search::make_result(Move best_move, int score, int depth) const {
+    const IterationStats last = iteration_stats(depth, nodes_, 0.0);
+    SearchResult result;
+    result.best_move = best_move;
+    result.score_cp = score;
+    result.depth = depth;
+    result.nodes = nodes_;
+    result.seldepth = last.seldepth;
+    result.time_ms = last.time_ms;
+    result.nps = last.nps;
+    result.hashfull = last.hashfull;
+    result.stats = stats_;
+    result.root_moves = root_moves_;
+    return result;
+}
+
 // ── Time / cancellation check ───────────────────────────────────────────────
 
 bool Search::should_stop() const {
-    if (cancelled_.load(std::memory_order_relaxed))
-        return true;
+    // The deadline and the external stop flag reach cancelled_ through the
+    // watchdog, so the hot path never reads the clock.
+    return cancelled_.load(std::memory_order_relaxed) || nodes_ >= node_limit_;
+}
+
+// ── Watchdog ────────────────────────────────────────────────────────────────
+
+void Search::arm_watchdog() {
+    if (!has_deadline_ && stop_flag_ == nullptr)
+        return;
+    {
+        std::lock_guard lock(watchdog_mutex_);
+        watchdog_armed_ = true;
+    }
+    if (!watchdog_.joinable()) {
+        watchdog_ = std::thread([this] { watchdog_loop(); });
+    } else {
+        watchdog_cv_.notify_one();
+    }
+}
 
-    if (has_deadline_ && (nodes_ & (kTimeCheckInterval - 1)) == 0) {
-        return std::chrono::steady_clock::now() >= deadline_;
+void Search::disarm_watchdog() {
+    // Once this returns the watchdog cannot raise cancelled_ for the
+    // finished search.
+    std::lock_guard lock(watchdog_mutex_);
+    watchdog_armed_ = false;
+}
+
+void Search::watchdog_loop() {
+    std::unique_lock lock(watchdog_mutex_);
+    while (!watchdog_exit_) {
+        if (!watchdog_armed_) {
+            watchdog_cv_.wait(lock);
+            continue;
+        }
+        const auto now = std::chrono::steady_clock::now();
+        if ((has_deadline_ && now >= deadline_) ||
+            (stop_flag_ != nullptr && stop_flag_->load(std::memory_order_relaxed))) {
+            cancelled_.store(true, std::memory_order_relaxed);
+            watchdog_armed_ = false;
+            continue;
+        }
+        auto wake = has_deadline_ ? deadline_ : std::chrono::steady_clock::time_point::max();
+        if (stop_flag_ != nullptr)
+            wake = std::min(wake, now + kStopFlagPollInterval);
+        watchdog_cv_.wait_until(lock, wake);
     }
-    return false;
 }
 
 // ── Draw detection ──────────────────────────────────────────────────────────
@@ -522,40 +958,8 @@ bool Search::is_draw(const Position& pos) const {
     if (pos.repetition_count() >= 2)
         return true;
 
-    // Insufficient material:
-    // K vs K, K+N vs K, K+B vs K
-    const Board& board = pos.board();
-    Bitboard all = board.occupied_all();
-    int total_pieces = popcount(all);
-
-    if (total_pieces == 2)
-        return true;  // K vs K
-
-    if (total_pieces == 3) {
-        // K+minor vs K
-        for (int c = 0; c < 2; ++c) {
-            auto color = static_cast<Color>(c);
-            if (board.pieces(color, PieceType::Knight) || board.pieces(color, PieceType::Bishop)) {
-                return true;
-            }
-        }
-    }
-
-    // K+B vs K+B on same color diagonals
-    if (total_pieces == 4) {
-        Bitboard wb = board.pieces(Color::White, PieceType::Bishop);
-        Bitboard bb = board.pieces(Color::Black, PieceType::Bishop);
-        if (wb && bb) {
-            // Light squares: (file + rank) even; dark squares: odd
-            constexpr Bitboard kLightSquares = 0x55AA55AA55AA55AAULL;
-            bool w_light = (wb & kLightSquares) != 0;
-            bool b_light = (bb & kLightSquares) != 0;
-            if (w_light == b_light)
-                return true;
-        }
-    }
-
-    return false;
+    // Insufficient material
+    return pos.is_insufficient_material();
 }
 
 // ── Non-pawn material check ─────────────────────────────────────────────────
@@ -0,0 +1,193 @@
+/// @file trace.cpp
+/// Per-thread span ring buffers and Chrome trace JSON export.
+
+#include <chessie/trace.hpp>
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstdio>
+#include <fstream>
+#include <memory>
+#include <mutex>
+#include <vector>
+
+namespace chessie::trace {
+
+namespace {
+
+static_assert((kRingCapacity & (kRingCapacity - 1)) == 0, "ring capacity must be a power of 2");
+
+/// Ring buffer owned by one recording thread.
+struct ThreadBuffer {
+    explicit ThreadBuffer(std::uint32_t id) : tid(id) {}
+
+    std::uint32_t tid;
+    std::atomic<std::uint64_t> head{0};  ///< Spans ever recorded (slot = head % capacity).
+    std::unique_ptr<Event[]> slots = std::make_unique<Event[]>(kRingCapacity);
+};
+
+/// All buffers ever created. A thread hands its buffer back when it exits
+/// and the next new thread reuses it, so there are only as many buffers as
+/// threads ever recorded at once. Spans of finished threads stay in their
+/// buffer, and in the dump, until the new owner overwrites them.
+struct Registry {
+    std::mutex mutex;
+    std::vector<std::unique_ptr<ThreadBuffer>> buffers;
+    std::vector<ThreadBuffer*> free;  ///< Buffers of exited threads, reused last-in first.
+};
+
+Registry& registry() {
+    // Never destroyed: detached threads may still exit after static teardown.
+    static Registry* const instance = new Registry();
+    return *instance;
+}
+
+/// The calling thread's claim on a buffer, returned when the thread exits.
+struct BufferLease {
+    BufferLease() {
+        Registry& reg = registry();
+        std::lock_guard lock(reg.mutex);
+        if (!reg.free.empty()) {
+            buffer = reg.free.back();
+            reg.free.pop_back();
+            return;
+        }
+        const auto id = static_cast<std::uint32_t>(reg.buffers.size());
+        reg.buffers.push_back(std::make_unique<ThreadBuffer>(id));
+        buffer = reg.buffers.back().get();
+    }
+
+    ~BufferLease() {
+        Registry& reg = registry();
+        std::lock_guard lock(reg.mutex);
+        reg.free.push_back(buffer);
+    }
+
+    BufferLease(const BufferLease&) = delete;
+    BufferLease& operator=(const BufferLease&) = delete;
+
+    ThreadBuffer* buffer = nullptr;
+};
+
+ThreadBuffer& local_buffer() {
+    thread_local BufferLease lease;
+    return *lease.buffer;
+}
+
+/// Append `text` as a JSON string literal.
+void append_json_string(std::string& out, const char* text) {
+    out += '"';
+    for (const char* p = text; *p != '\0'; ++p) {
+        const auto c = static_cast<unsigned char>(*p);
+        if (c == '"' || c == '\\') {
+            out += '\\';
+            out += static_cast<char>(c);
+        } else if (c < 0x20) {
+            char buf[8];
+            std::snprintf(buf, sizeof(buf), "\\u%04x", c);
+            out += buf;
+        } else {
+            out += static_cast<char>(c);
+        }
+    }
+    out += '"';
+}
+
+void append_event(std::string& out, const Event& e, std::uint32_t tid) {
+    char buf[128];
+    out += "{\"name\":";
+    append_json_string(out, e.name != nullptr ? e.name : "?");
+    std::snprintf(buf, sizeof(buf), ",\"cat\":\"chessie\",\"ph\":\"X\",\"ts\":%.3f,\"dur\":%.3f",
+                  static_cast<double>(e.begin_ns) / 1000.0,
+                  static_cast<double>(e.end_ns - e.begin_ns) / 1000.0);
+    out += buf;
+    std::snprintf(buf, sizeof(buf), ",\"pid\":1,\"tid\":%u", static_cast<unsigned>(tid));
+    out += buf;
+
+    const bool has_arg = e.arg != kNoArg;
+    const bool has_detail = e.detail[0] != '\0';
+    if (has_arg || has_detail) {
+        out += ",\"args\":{";
+        if (has_arg) {
+            std::snprintf(buf, sizeof(buf), "\"value\":%lld", static_cast<long long>(e.arg));
+            out += buf;
+        }
+        if (has_detail) {
+            std::array<char, 8> detail = e.detail;
+            detail.back() = '\0';
+            out += has_arg ? ",\"detail\":" : "\"detail\":";
+            append_json_string(out, detail.data());
+        }
+        out += '}';
+    }
+    out += '}';
+}
+
+}  // namespace
+
+// ── Recording ───────────────────────────────────────────────────────────────
+
+std::uint64_t now_ns() noexcept {
+    static const auto epoch = std::chrono::steady_clock::now();
+    return static_cast<std::uint64_t>(
+        std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now() -
+                                                             epoch)
+            .count());
+}
+
+void record(const Event& event) noexcept {
+    ThreadBuffer& buffer = local_buffer();
+    const std::uint64_t head = buffer.head.load(std::memory_order_relaxed);
+    buffer.slots[head & (kRingCapacity - 1)] = event;
+    buffer.head.store(head + 1, std::memory_order_release);
+}
+
+void clear() noexcept {
+    Registry& reg = registry();
+    std::lock_guard lock(reg.mutex);
+    for (const auto& buffer : reg.buffers) buffer->head.store(0, std::memory_order_relaxed);
+}
+
+std::size_t size() noexcept {
+    Registry& reg = registry();
+    std::lock_guard lock(reg.mutex);
+    std::size_t total = 0;
+    for (const auto& buffer : reg.buffers) {
+        const std::uint64_t head = buffer->head.load(std::memory_order_acquire);
+        total += static_cast<std::size_t>(std::min<std::uint64_t>(head, kRingCapacity));
+    }
+    return total;
+}
+
+// ── Export ──────────────────────────────────────────────────────────────────
+
+std::string dump_json() {
+    Registry& reg = registry();
+    std::lock_guard lock(reg.mutex);
+
+    std::string out = "{\"displayTimeUnit\":\"ms\",\"traceEvents\":[";
+    bool first = true;
+    for (const auto& buffer : reg.buffers) {
+        const std::uint64_t head = buffer->head.load(std::memory_order_acquire);
+        const std::uint64_t count = std::min<std::uint64_t>(head, kRingCapacity);
+        for (std::uint64_t i = head - count; i < head; ++i) {
+            if (!first)
+                out += ",\n";
+            first = false;
+            append_event(out, buffer->slots[i & (kRingCapacity - 1)], buffer->tid);
+        }
+    }
+    out += "]}\n";
+    return out;
+}
+
+bool write_json(const std::string& path) {
+    std::ofstream file(path, std::ios::binary);
+    if (!file)
+        return false;
+    file << dump_json();
+    return static_cast<bool>(file);
+}
+
+}  // namespace chessie::trace
@@ -1,10 +1,12 @@
 /// @file tt.cpp
 /// Transposition table implementation.
 
+#include <chessie/trace.hpp>
 #include <chessie/tt.hpp>
 
 #include <algorithm>
-#include <cstring>
+#include <cstdlib>
+#include <new>
 
 namespace chessie {
 
@@ -23,47 +25,201 @@ static std::size_t round_down_pow2(std::size_t v) noexcept {
     return (v >> 1) + 1;
 }
 
+// ── Slot encoding ───────────────────────────────────────────────────────────
+//
+// data: score (16) | static eval (16) | best move (32)
+// meta: key32 (32) | key hint (8) | depth (8) | bound (8) | age (8)
+//
+// The key hint holds key bits 16..23. Probes check it as extra verification
+// for tables below 2^24 entries, and rehash() uses it to place entries when
+// the table grows.
+
+namespace {
+
+constexpr int kHintShift = 16;
+constexpr int kHintBits = 8;
+
+std::uint64_t key_hint(std::uint64_t key) noexcept {
+    return (key >> kHintShift) & 0xFF;
+}
+
+std::uint64_t pack_data(int score, int static_eval, Move m) noexcept {
+    const std::uint64_t move = std::uint64_t{m.from_sq} | std::uint64_t{m.to_sq} << 8 |
+                               std::uint64_t{static_cast<std::uint8_t>(m.flag)} << 16 |
+                               std::uint64_t{static_cast<std::uint8_t>(m.promotion)} << 24;
+    return std::uint64_t{static_cast<std::uint16_t>(score)} |
+           std::uint64_t{static_cast<std::uint16_t>(static_eval)} << 16 | move << 32;
+}
+
+std::uint64_t pack_meta(std::uint64_t key, int depth, Bound bound, std::uint8_t age) noexcept {
+    return (key & 0xFFFFFFFF00000000ULL) | key_hint(key) << 24 |
+           std::uint64_t{static_cast<std::uint8_t>(depth)} << 16 |
+           std::uint64_t{static_cast<std::uint8_t>(bound)} << 8 | age;
+}
+
+/// Do `meta` and `key` agree on the upper 32 bits and the hint byte?
+bool meta_matches(std::uint64_t meta, std::uint64_t key) noexcept {
+    return (meta >> 24) == ((key >> 32) << 8 | key_hint(key));
+}
+
+Bound bound_of(std::uint64_t meta) noexcept {
+    return static_cast<Bound>((meta >> 8) & 0xFF);
+}
+
+std::int8_t depth_of(std::uint64_t meta) noexcept {
+    return static_cast<std::int8_t>((meta >> 16) & 0xFF);
+}
+
+TTEntry decode(std::uint64_t data, std::uint64_t meta) noexcept {
+    TTEntry entry;
+    entry.key32 = static_cast<std::uint32_t>(meta >> 32);
+    entry.score = static_cast<std::int16_t>(data & 0xFFFF);
+    entry.static_eval = static_cast<std::int16_t>((data >> 16) & 0xFFFF);
+    entry.best_move.from_sq = static_cast<Square>((data >> 32) & 0xFF);
+    entry.best_move.to_sq = static_cast<Square>((data >> 40) & 0xFF);
+    entry.best_move.flag = static_cast<MoveFlag>((data >> 48) & 0xFF);
+    entry.best_move.promotion = static_cast<PieceType>((data >> 56) & 0xFF);
+    entry.depth = depth_of(meta);
+    entry.bound = bound_of(meta);
+    entry.age = static_cast<std::uint8_t>(meta & 0xFF);
+    return entry;
+}
+
+/// Entry count for a size in megabytes: a power of 2, at least 1024.
+std::size_t entries_for(std::size_t mb, std::size_t slot_size) noexcept {
+    if (mb == 0)
+        mb = 1;
+    const std::size_t bytes = mb * 1024ULL * 1024ULL;
+    return std::max(round_down_pow2(bytes / slot_size), std::size_t{1024});
+}
+
+/// When two entries collide in rehash(), should `meta` displace `other`?
+/// The current search's entry wins, then the deeper one.
+bool rehash_prefers(std::uint64_t meta, std::uint64_t other, std::uint8_t age) noexcept {
+    const bool current = (meta & 0xFF) == age;
+    const bool other_current = (other & 0xFF) == age;
+    if (current != other_current)
+        return current;
+    return depth_of(meta) > depth_of(other);
+}
+
+int log2_pow2(std::size_t v) noexcept {
+    int n = 0;
+    while ((std::size_t{1} << n) < v) ++n;
+    return n;
+}
+
+}  // namespace
+
 // ── TranspositionTable ──────────────────────────────────────────────────────
 
 TranspositionTable::TranspositionTable(std::size_t mb) {
     resize(mb);
 }
 
+TranspositionTable::~TranspositionTable() {
+    std::free(table_.load(std::memory_order_relaxed));
+}
+
 void TranspositionTable::resize(std::size_t mb) {
-    if (mb == 0)
-        mb = 1;
+    CHESSIE_TRACE_SPAN(span, "tt_resize", static_cast<std::int64_t>(mb));
+    const std::size_t num_entries = entries_for(mb, sizeof(Slot));
 
-    // Calculate how many entries fit in the given MB
-    constexpr std::size_t kEntrySize = sizeof(TTEntry);
-    std::size_t bytes = mb * 1024ULL * 1024ULL;
-    std::size_t num_entries = bytes / kEntrySize;
+    std::free(table_.exchange(nullptr, std::memory_order_acq_rel));
+    count_ = num_entries;
+    mask_ = num_entries - 1;
+    age_.store(0, std::memory_order_relaxed);
+}
 
-    // Round down to power of 2
-    num_entries = round_down_pow2(num_entries);
+void TranspositionTable::rehash(std::size_t mb) {
+    CHESSIE_TRACE_SPAN(span, "tt_rehash", static_cast<std::int64_t>(mb));
+    const std::size_t new_count = entries_for(mb, sizeof(Slot));
+    Slot* old_table = table_.load(std::memory_order_acquire);
+    if (new_count == count_)
+        return;
+    if (old_table == nullptr) {
+        count_ = new_count;
+        mask_ = new_count - 1;
+        return;
+    }
 
-    // Minimum 1024 entries
-    num_entries = std::max(num_entries, std::size_t{1024});
+    auto* new_table = static_cast<Slot*>(std::calloc(new_count, sizeof(Slot)));
+    if (new_table == nullptr)
+        throw std::bad_alloc();
 
-    table_.assign(num_entries, TTEntry{});
-    mask_ = num_entries - 1;
-    age_ = 0;
+    // Growing needs the index bits between the old and new sizes; only the
+    // hint bits are recorded.
+    const int old_bits = log2_pow2(count_);
+    const int new_bits = log2_pow2(new_count);
+    const bool placeable =
+        new_count < count_ || (old_bits >= kHintShift && new_bits <= kHintShift + kHintBits);
+
+    const std::uint8_t age = age_.load(std::memory_order_relaxed);
+    const std::size_t new_mask = new_count - 1;
+    for (std::size_t i = 0; placeable && i < count_; ++i) {
+        const std::uint64_t data = old_table[i].data.load(std::memory_order_relaxed);
+        const std::uint64_t meta = old_table[i].check.load(std::memory_order_relaxed) ^ data;
+        if (bound_of(meta) == Bound::None)
+            continue;
+
+        const std::uint64_t low_key = i | ((meta >> 24) & 0xFF) << kHintShift;
+        Slot& slot = new_table[low_key & new_mask];
+        const std::uint64_t slot_data = slot.data.load(std::memory_order_relaxed);
+        const std::uint64_t slot_meta = slot.check.load(std::memory_order_relaxed) ^ slot_data;
+        if (bound_of(slot_meta) != Bound::None && !rehash_prefers(meta, slot_meta, age))
+            continue;
+        slot.data.store(data, std::memory_order_relaxed);
+        slot.check.store(meta ^ data, std::memory_order_relaxed);
+    }
+
+    table_.store(new_table, std::memory_order_release);
+    std::free(old_table);
+    count_ = new_count;
+    mask_ = new_mask;
 }
 
 void TranspositionTable::clear() {
-    std::fill(table_.begin(), table_.end(), TTEntry{});
-    age_ = 0;
+    CHESSIE_TRACE_SCOPE("tt_clear");
+    // Zero the slots in place: engines sharing the table may be probing or
+    // storing into it right now.
+    if (Slot* table = table_.load(std::memory_order_acquire)) {
+        for (std::size_t i = 0; i < count_; ++i) {
+            table[i].check.store(0, std::memory_order_relaxed);
+            table[i].data.store(0, std::memory_order_relaxed);
+        }
+    }
+    age_.store(0, std::memory_order_relaxed);
 }
 
-void TranspositionTable::new_search() noexcept {
-    ++age_;
+TranspositionTable::Slot* TranspositionTable::allocate() noexcept {
+    std::lock_guard lock(alloc_mutex_);
+    Slot* table = table_.load(std::memory_order_acquire);
+    if (table == nullptr) {
+        CHESSIE_TRACE_SCOPE("tt_allocate");
+        // Slot is an aggregate of atomics, so calloc'd zero bytes are valid
+        // empty slots; large blocks come straight from the OS as zero pages.
+        table = static_cast<Slot*>(std::calloc(count_, sizeof(Slot)));
+        table_.store(table, std::memory_order_release);
+    }
+    return table;
+}
+
+void TranspositionTable::new_search() {
+    if (!allocated() && allocate() == nullptr)
+        throw std::bad_alloc();
+    age_.fetch_add(1, std::memory_order_relaxed);
 }
 
 bool TranspositionTable::probe(std::uint64_t key, TTEntry& entry) const noexcept {
-    const auto idx = index(key);
-    const auto& slot = table_[idx];
+    const Slot* table = table_.load(std::memory_order_acquire);
+    if (table == nullptr)
+        return false;
+    const Slot& slot = table[index(key)];
+    const std::uint64_t data = slot.data.load(std::memory_order_relaxed);
+    const std::uint64_t meta = slot.check.load(std::memory_order_relaxed) ^ data;
 
-    if (slot.bound != Bound::None && slot.key32 == key_upper(key)) {
-        entry = slot;
+    if (bound_of(meta) != Bound::None && meta_matches(meta, key)) {
+        entry = decode(data, meta);
         return true;
     }
     return false;
@@ -71,9 +227,17 @@ bool TranspositionTable::probe(std::uint64_t key, TTEntry& entry) const noexcept
 
 void TranspositionTable::store(std::uint64_t key, int depth, int score, Bound bound, Move best_move,
                                int static_eval) noexcept {
-    const auto idx = index(key);
-    auto& slot = table_[idx];
-    const auto key32 = key_upper(key);
+    Slot* table = table_.load(std::memory_order_acquire);
+    if (table == nullptr && (table = allocate()) == nullptr)
+        return;
+    Slot& slot = table[index(key)];
+    const std::uint8_t age = age_.load(std::memory_order_relaxed);
+
+    // Whatever the slot holds, for any key. A torn slot decodes to an
+    // arbitrary key and is simply replaced or kept like any other entry.
+    const std::uint64_t old_data = slot.data.load(std::memory_order_relaxed);
+    const std::uint64_t old_meta = slot.check.load(std::memory_order_relaxed) ^ old_data;
+    const TTEntry old = decode(old_data, old_meta);
 
     // Replacement policy:
     // 1. Always replace empty entries.
@@ -81,35 +245,38 @@ void TranspositionTable::store(std::uint64_t key, int depth, int score, Bound bo
     // 3. For same-age entries, replace if new depth >= stored depth,
     //    or if the new entry is exact and the old one isn't.
     bool should_replace =
-        (slot.bound == Bound::None)                                // empty
-        || (slot.age != age_)                                      // stale
-        || (depth >= slot.depth)                                   // deeper or equal
-        || (bound == Bound::Exact && slot.bound != Bound::Exact);  // exact > non-exact
+        (old.bound == Bound::None)                                // empty
+        || (old.age != age)                                       // stale
+        || (depth >= old.depth)                                   // deeper or equal
+        || (bound == Bound::Exact && old.bound != Bound::Exact);  // exact > non-exact
 
     if (!should_replace)
         return;
 
     // If we're storing to existing entry with same key, preserve best_move if new one is null
-    if (slot.key32 == key32 && best_move.is_null() && !slot.best_move.is_null()) {
-        best_move = slot.best_move;
+    if (meta_matches(old_meta, key) && best_move.is_null() && !old.best_move.is_null()) {
+        best_move = old.best_move;
     }
 
-    slot.key32 = key32;
-    slot.score = static_cast<std::int16_t>(score);
-    slot.static_eval = static_cast<std::int16_t>(static_eval);
-    slot.best_move = best_move;
-    slot.depth = static_cast<std::uint8_t>(depth);
-    slot.bound = bound;
-    slot.age = age_;
+    const std::uint64_t data = pack_data(score, static_eval, best_move);
+    slot.data.store(data, std::memory_order_relaxed);
+    slot.check.store(pack_meta(key, depth, bound, age) ^ data, std::memory_order_relaxed);
 }
 
 int TranspositionTable::hashfull() const noexcept {
-    if (table_.empty())
+    const Slot* table = table_.load(std::memory_order_acquire);
+    if (table == nullptr)
         return 0;
-    const std::size_t sample_size = std::min(table_.size(), std::size_t{1000});
+    // Stride across the whole table: the low indices alone are not a fair
+    // sample, since keys with small low bits cluster there.
+    const std::size_t sample_size = std::min(count_, std::size_t{1000});
+    const std::uint8_t age = age_.load(std::memory_order_relaxed);
     int used = 0;
     for (std::size_t i = 0; i < sample_size; ++i) {
-        if (table_[i].bound != Bound::None && table_[i].age == age_) {
+        const Slot& slot = table[i * count_ / sample_size];
+        const std::uint64_t meta =
+            slot.check.load(std::memory_order_relaxed) ^ slot.data.load(std::memory_order_relaxed);
+        if (bound_of(meta) != Bound::None && (meta & 0xFF) == age) {
             ++used;
         }
     }
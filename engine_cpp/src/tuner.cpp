@@ -0,0 +1,373 @@
+/// @file tuner.cpp
+/// Texel tuner implementation: dataset packing, memory mapping, traces, Adam.
+
+#include <chessie/tuner.hpp>
+
+#include <algorithm>
+#include <cmath>
+#include <fstream>
+#include <istream>
+#include <ostream>
+#include <stdexcept>
+#include <string>
+#include <string_view>
+#include <thread>
+
+#if defined(__unix__) || defined(__APPLE__)
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#define CHESSIE_HAVE_MMAP 1
+#endif
+
+namespace chessie::tune {
+
+namespace {
+
+constexpr double kLn10 = 2.302585092994046;
+
+// Adam hyper-parameters.
+constexpr double kBeta1 = 0.9;
+constexpr double kBeta2 = 0.999;
+constexpr double kEpsilon = 1e-8;
+
+/// Run `fn(thread_index, begin, end)` over [0, n) split into `threads` chunks.
+template <typename Fn>
+void parallel_for(std::size_t n, int threads, Fn&& fn) {
+    const auto t = static_cast<std::size_t>(std::max(1, threads));
+    const std::size_t chunk = (n + t - 1) / t;
+    std::vector<std::thread> pool;
+    for (std::size_t i = 0; i < t; ++i) {
+        std::size_t begin = i * chunk;
+        std::size_t end = std::min(n, begin + chunk);
+        if (begin >= end)
+            break;
+        pool.emplace_back([&fn, i, begin, end]() { fn(i, begin, end); });
+    }
+    for (auto& th : pool) th.join();
+}
+
+/// Texel sigmoid: expected white score for a white-perspective eval.
+double sigmoid(double k, double eval) {
+    return 1.0 / (1.0 + std::exp(-k * kLn10 * eval / 400.0));
+}
+
+/// Parse a game-result token. Returns -1 on failure.
+double parse_result(std::string_view tok) {
+    while (!tok.empty() && (tok.front() == '"' || tok.front() == '[')) tok.remove_prefix(1);
+    while (!tok.empty() && (tok.back() == '"' || tok.back() == ']' || tok.back() == ';'))
+        tok.remove_suffix(1);
+    if (tok == "1-0" || tok == "1.0" || tok == "1")
+        return 1.0;
+    if (tok == "0-1" || tok == "0.0" || tok == "0")
+        return 0.0;
+    if (tok == "1/2-1/2" || tok == "0.5")
+        return 0.5;
+    return -1.0;
+}
+
+bool is_number(std::string_view tok) {
+    return !tok.empty() &&
+           std::all_of(tok.begin(), tok.end(), [](char c) { return c >= '0' && c <= '9'; });
+}
+
+}  // namespace
+
+// ── Packing ─────────────────────────────────────────────────────────────────
+
+PackedPosition pack(const Position& pos, double white_result) {
+    const Board& board = pos.board();
+    PackedPosition packed{};
+    packed.occupancy = board.occupied_all();
+    if (popcount(packed.occupancy) > 32) {
+        throw std::invalid_argument("Cannot pack position with more than 32 pieces");
+    }
+
+    Bitboard occ = packed.occupancy;
+    for (int i = 0; occ; ++i) {
+        Piece p = board.piece_at(pop_lsb(occ));
+        auto code =
+            static_cast<std::uint8_t>((color_index(p.color) << 3) | static_cast<int>(p.type));
+        packed.pieces[i / 2] |= static_cast<std::uint8_t>(code << ((i & 1) * 4));
+    }
+    packed.side = static_cast<std::uint8_t>(color_index(pos.side_to_move()));
+    packed.result = static_cast<std::uint8_t>(std::lround(white_result * 2.0));
+    return packed;
+}
+
+Position unpack(const PackedPosition& packed) {
+    Board board;
+    Bitboard occ = packed.occupancy;
+    for (int i = 0; occ; ++i) {
+        Square sq = pop_lsb(occ);
+        int code = (packed.pieces[i / 2] >> ((i & 1) * 4)) & 0xF;
+        board.put_piece(sq, {static_cast<Color>(code >> 3), static_cast<PieceType>(code & 7)});
+    }
+    return Position(board, static_cast<Color>(packed.side & 1), kCastlingNone, kNoSquare, 0, 1);
+}
+
+std::size_t convert_text(std::istream& in, std::ostream& out) {
+    std::size_t written = 0;
+    std::string line;
+    while (std::getline(in, line)) {
+        std::vector<std::string_view> tokens;
+        std::string_view sv = line;
+        while (!sv.empty()) {
+            std::size_t start = sv.find_first_not_of(" \t\r");
+            if (start == std::string_view::npos)
+                break;
+            sv.remove_prefix(start);
+            std::size_t end = std::min(sv.find_first_of(" \t\r"), sv.size());
+            tokens.push_back(sv.substr(0, end));
+            sv.remove_prefix(end);
+        }
+        if (tokens.size() < 5)
+            continue;
+
+        double result = parse_result(tokens.back());
+        if (result < 0.0)
+            continue;
+
+        // Board, side, castling and EP are mandatory; clocks only if numeric.
+        std::string fen;
+        std::size_t fields = 4;
+        while (fields < 6 && fields < tokens.size() - 1 && is_number(tokens[fields])) ++fields;
+        for (std::size_t i = 0; i < fields; ++i) {
+            if (i > 0)
+                fen += ' ';
+            fen += tokens[i];
+        }
+
+        try {
+            PackedPosition packed = pack(Position::from_fen(fen), result);
+            out.write(reinterpret_cast<const char*>(&packed), sizeof(packed));
+            ++written;
+        } catch (const std::invalid_argument&) {
+            // Skip malformed positions.
+        }
+    }
+    return written;
+}
+
+// ── Dataset ─────────────────────────────────────────────────────────────────
+
+Dataset::Dataset(const std::string& path, bool use_mmap) {
+#ifdef CHESSIE_HAVE_MMAP
+    if (use_mmap) {
+        int fd = ::open(path.c_str(), O_RDONLY);
+        if (fd < 0) {
+            throw std::runtime_error("Cannot open dataset: " + path);
+        }
+        struct stat st{};
+        if (::fstat(fd, &st) != 0) {
+            ::close(fd);
+            throw std::runtime_error("Cannot stat dataset: " + path);
+        }
+        auto bytes = static_cast<std::size_t>(st.st_size);
+        if (bytes % sizeof(PackedPosition) != 0) {
+            ::close(fd);
+            throw std::runtime_error("Truncated dataset: " + path);
+        }
+        if (bytes > 0) {
+            void* base = ::mmap(nullptr, bytes, PROT_READ, MAP_PRIVATE, fd, 0);
+            if (base == MAP_FAILED) {
+                ::close(fd);
+                throw std::runtime_error("Cannot map dataset: " + path);
+            }
+            ::madvise(base, bytes, MADV_SEQUENTIAL);
+            mapping_ = base;
+            mapping_bytes_ = bytes;
+            data_ = static_cast<const PackedPosition*>(base);
+            size_ = bytes / sizeof(PackedPosition);
+        }
+        ::close(fd);
+        return;
+    }
+#else
+    (void)use_mmap;
+#endif
+
+    std::ifstream in(path, std::ios::binary | std::ios::ate);
+    if (!in) {
+        throw std::runtime_error("Cannot open dataset: " + path);
+    }
+    auto bytes = static_cast<std::size_t>(in.tellg());
+    if (bytes % sizeof(PackedPosition) != 0) {
+        throw std::runtime_error("Truncated dataset: " + path);
+    }
+    buffer_.resize(bytes / sizeof(PackedPosition));
+    in.seekg(0);
+    in.read(reinterpret_cast<char*>(buffer_.data()), static_cast<std::streamsize>(bytes));
+    if (!in) {
+        throw std::runtime_error("Cannot read dataset: " + path);
+    }
+    data_ = buffer_.data();
+    size_ = buffer_.size();
+}
+
+Dataset::~Dataset() {
+#ifdef CHESSIE_HAVE_MMAP
+    if (mapping_ != nullptr) {
+        ::munmap(mapping_, mapping_bytes_);
+    }
+#endif
+}
+
+// ── Tuner ───────────────────────────────────────────────────────────────────
+
+Tuner::Tuner(std::span<const PackedPosition> positions, const eval::Params& initial,
+             int threads)
+    : weights_(2 * eval::Params::kNumTerms),
+      moment1_(2 * eval::Params::kNumTerms, 0.0),
+      moment2_(2 * eval::Params::kNumTerms, 0.0) {
+    threads_ = threads > 0 ? threads : static_cast<int>(std::thread::hardware_concurrency());
+    threads_ = std::max(1, threads_);
+
+    for (std::size_t i = 0; i < initial.terms.size(); ++i) {
+        weights_[2 * i] = initial.terms[i].mg;
+        weights_[2 * i + 1] = initial.terms[i].eg;
+    }
+
+    // Trace each chunk independently, then splice the chunks together.
+    struct Chunk {
+        std::vector<eval::TraceTerm> terms;
+        std::vector<Entry> entries;
+    };
+    std::vector<Chunk> chunks(static_cast<std::size_t>(threads_));
+    auto trace_chunk = [&](std::size_t t, std::size_t begin, std::size_t end) {
+        Chunk& chunk = chunks[t];
+        chunk.entries.reserve(end - begin);
+        eval::Trace tr;
+        for (std::size_t i = begin; i < end; ++i) {
+            eval::trace(unpack(positions[i]), initial, tr);
+            chunk.entries.push_back({static_cast<std::uint32_t>(chunk.terms.size()),
+                                     static_cast<std::uint16_t>(tr.terms.size()),
+                                     static_cast<std::uint8_t>(tr.phase),
+                                     static_cast<float>(white_result(positions[i]))});
+            chunk.terms.insert(chunk.terms.end(), tr.terms.begin(), tr.terms.end());
+        }
+    };
+    parallel_for(positions.size(), threads_, trace_chunk);
+
+    entries_.reserve(positions.size());
+    for (Chunk& chunk : chunks) {
+        auto base = static_cast<std::uint32_t>(terms_.size());
+        for (Entry e : chunk.entries) {
+            e.begin += base;
+            entries_.push_back(e);
+        }
+        terms_.insert(terms_.end(), chunk.terms.begin(), chunk.terms.end());
+    }
+}
+
+double Tuner::linear_eval(const Entry& e) const noexcept {
+    double mg = 0.0;
+    double eg = 0.0;
+    for (std::uint32_t i = e.begin; i < e.begin + e.count; ++i) {
+        const eval::TraceTerm& t = terms_[i];
+        mg += t.coef * weights_[2 * std::size_t{t.index}];
+        eg += t.coef * weights_[2 * std::size_t{t.index} + 1];
+    }
+    return (mg * e.phase + eg * (eval::kTotalPhase - e.phase)) / eval::kTotalPhase;
+}
+
+double Tuner::error(double k) const {
+    if (entries_.empty())
+        return 0.0;
+    std::vector<double> partial(static_cast<std::size_t>(threads_), 0.0);
+    parallel_for(entries_.size(), threads_, [&](std::size_t t, std::size_t begin, std::size_t end) {
+        double sum = 0.0;
+        for (std::size_t i = begin; i < end; ++i) {
+            double diff = entries_[i].result - sigmoid(k, linear_eval(entries_[i]));
+            sum += diff * diff;
+        }
+        partial[t] = sum;
+    });
+    double total = 0.0;
+    for (double p : partial) total += p;
+    return total / static_cast<double>(entries_.size());
+}
+
+double Tuner::find_k() const {
+    // Successively refined grid search; the error is unimodal in k.
+    double best_k = 1.0;
+    double lo = 0.0;
+    double hi = 4.0;
+    for (int round = 0; round < 6; ++round) {
+        double step = (hi - lo) / 10.0;
+        double best_err = error(lo);
+        best_k = lo;
+        for (int i = 1; i <= 10; ++i) {
+            double k = lo + i * step;
+            double err = error(k);
+            if (err < best_err) {
+                best_err = err;
+                best_k = k;
+            }
+        }
+        lo = std::max(0.0, best_k - step);
+        hi = best_k + step;
+    }
+    return best_k;
+}
+
+double Tuner::step(double k, double learning_rate) {
+    const std::size_t n_weights = weights_.size();
+    std::vector<std::vector<double>> grads(static_cast<std::size_t>(threads_));
+    std::vector<double> partial(static_cast<std::size_t>(threads_), 0.0);
+
+    parallel_for(entries_.size(), threads_, [&](std::size_t t, std::size_t begin, std::size_t end) {
+        std::vector<double>& grad = grads[t];
+        grad.assign(n_weights, 0.0);
+        double sum = 0.0;
+        for (std::size_t i = begin; i < end; ++i) {
+            const Entry& e = entries_[i];
+            double s = sigmoid(k, linear_eval(e));
+            double diff = e.result - s;
+            sum += diff * diff;
+
+            // d(error)/d(eval), constant factors folded into the learning rate.
+            double g = -diff * s * (1.0 - s);
+            double g_mg = g * e.phase / eval::kTotalPhase;
+            double g_eg = g * (eval::kTotalPhase - e.phase) / eval::kTotalPhase;
+            for (std::uint32_t j = e.begin; j < e.begin + e.count; ++j) {
+                const eval::TraceTerm& term = terms_[j];
+                grad[2 * std::size_t{term.index}] += g_mg * term.coef;
+                grad[2 * std::size_t{term.index} + 1] += g_eg * term.coef;
+            }
+        }
+        partial[t] = sum;
+    });
+
+    ++iteration_;
+    const double correction1 = 1.0 - std::pow(kBeta1, iteration_);
+    const double correction2 = 1.0 - std::pow(kBeta2, iteration_);
+    for (std::size_t w = 0; w < n_weights; ++w) {
+        double g = 0.0;
+        for (const auto& grad : grads) {
+            if (!grad.empty())
+                g += grad[w];
+        }
+        moment1_[w] = kBeta1 * moment1_[w] + (1.0 - kBeta1) * g;
+        moment2_[w] = kBeta2 * moment2_[w] + (1.0 - kBeta2) * g * g;
+        double m_hat = moment1_[w] / correction1;
+        double v_hat = moment2_[w] / correction2;
+        weights_[w] -= learning_rate * m_hat / (std::sqrt(v_hat) + kEpsilon);
+    }
+
+    double total = 0.0;
+    for (double p : partial) total += p;
+    return entries_.empty() ? 0.0 : total / static_cast<double>(entries_.size());
+}
+
+eval::Params Tuner::params() const {
+    eval::Params p{};
+    for (std::size_t i = 0; i < p.terms.size(); ++i) {
+        p.terms[i] = {static_cast<int>(std::lround(weights_[2 * i])),
+                      static_cast<int>(std::lround(weights_[2 * i + 1]))};
+    }
+    return p;
+}
+
+}  // namespace chessie::tune
@@ -0,0 +1,55 @@
+/// @file test_attacks.cpp
+/// Tests for attack maps.
+
+#include <chessie/attacks.hpp>
+#include <chessie/magic.hpp>
+#include <chessie/movegen.hpp>
+#include <chessie/position.hpp>
+
+#include <gtest/gtest.h>
+#include <random>
+
+using namespace chessie;
+
+class AttacksTest : public ::testing::Test {
+   public:
+    static void SetUpTestSuite() { magic::init(); }
+};
+
+TEST_F(AttacksTest, StartingPosition) {
+    AttackMap map = compute_attacks(Board::initial());
+    EXPECT_EQ(map.attacked_by[0][0], kRank3);
+    EXPECT_EQ(map.attacked_by[1][0], kRank6);
+    EXPECT_EQ(map.attacked_by[0][1], square_bb(A3) | square_bb(C3) | square_bb(D2) |
+                                         square_bb(E2) | square_bb(F3) | square_bb(H3));
+    EXPECT_EQ(map.attacks_from[B1], knight_attacks(B1));
+    // Sliders stop at the first blocker, own pieces included.
+    EXPECT_EQ(map.attacks_from[D1], square_bb(C1) | square_bb(E1) | square_bb(C2) |
+                                        square_bb(D2) | square_bb(E2));
+    EXPECT_FALSE(test_bit(map.attacked_by[0][AttackMap::kAllPieces], E4));
+    EXPECT_TRUE(test_bit(map.attacked_by[1][AttackMap::kAllPieces], F6));
+}
+
+TEST_F(AttacksTest, MatchesSquareAttackQueries) {
+    std::mt19937 rng(7);
+    for (int game = 0; game < 4; ++game) {
+        Position pos = Position::initial();
+        for (int ply = 0; ply < 100; ++ply) {
+            MoveList moves = movegen::legal(pos);
+            if (moves.size() == 0)
+                break;
+            pos.make_move(moves[static_cast<int>(rng() % static_cast<unsigned>(moves.size()))]);
+
+            AttackMap map = compute_attacks(pos.board());
+            const Bitboard white = map.attacked_by[0][AttackMap::kAllPieces];
+            const Bitboard black = map.attacked_by[1][AttackMap::kAllPieces];
+            for (int sq = 0; sq < 64; ++sq) {
+                auto s = static_cast<Square>(sq);
+                ASSERT_EQ(test_bit(white, s), pos.is_square_attacked(s, Color::White))
+                    << pos.to_fen() << " " << sq;
+                ASSERT_EQ(test_bit(black, s), pos.is_square_attacked(s, Color::Black))
+                    << pos.to_fen() << " " << sq;
+            }
+        }
+    }
+}
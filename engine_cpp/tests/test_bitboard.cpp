@@ -123,6 +123,13 @@ TEST(Bitboard, ShiftEdgeCases) {
     EXPECT_EQ(shift_se(square_bb(H4)), kEmptyBB);
 }
 
+TEST(Bitboard, FlipVertical) {
+    EXPECT_EQ(flip_vertical(square_bb(E2)), square_bb(E7));
+    EXPECT_EQ(flip_vertical(square_bb(A8)), square_bb(A1));
+    EXPECT_EQ(flip_vertical(kRank2 | kFileH), kRank7 | kFileH);
+    EXPECT_EQ(flip_vertical(flip_vertical(0x0123456789ABCDEFULL)), 0x0123456789ABCDEFULL);
+}
+
 // ── Attack tables ───────────────────────────────────────────────────────────
 
 TEST(Bitboard, KnightAttacksCenter) {
@@ -194,4 +201,27 @@ TEST(Bitboard, PawnAttacksEdge) {
     EXPECT_TRUE(test_bit(attacks, G6));
 }
 
+// ── Lines ───────────────────────────────────────────────────────────────────
+
+TEST(Bitboard, BetweenAndLine) {
+    EXPECT_EQ(between_bb(A1, D4), square_bb(B2) | square_bb(C3));
+    EXPECT_EQ(between_bb(D4, A1), between_bb(A1, D4));
+    EXPECT_EQ(between_bb(E1, E2), kEmptyBB);
+    EXPECT_EQ(between_bb(A1, B3), kEmptyBB);  // knight hop: not aligned
+
+    EXPECT_EQ(line_bb(C1, C5), kFileC);
+    EXPECT_EQ(line_bb(B2, G7), line_bb(A1, H8));
+    EXPECT_EQ(popcount(line_bb(A1, H8)), 8);
+    EXPECT_EQ(line_bb(A1, B3), kEmptyBB);
+
+    EXPECT_TRUE(aligned(A1, C3, H8));
+    EXPECT_FALSE(aligned(A1, C3, H7));
+}
+
+TEST(Bitboard, EmptyBoardRays) {
+    EXPECT_EQ(rook_rays(A1), (kFileA | kRank1) & ~square_bb(A1));
+    EXPECT_EQ(popcount(bishop_rays(D4)), 13);
+    EXPECT_EQ(popcount(bishop_rays(H1)), 7);
+}
+
 }  // namespace chessie
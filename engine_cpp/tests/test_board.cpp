@@ -117,6 +117,15 @@ TEST(Board, MovePiece) {
     EXPECT_EQ(b.piece_at(D5), Piece(Color::Black, PieceType::Queen));
     EXPECT_FALSE(test_bit(b.occupied_all(), D1));
     EXPECT_TRUE(test_bit(b.occupied_all(), D5));
+    EXPECT_EQ(b.type_at(D5), PieceType::Queen);
+    EXPECT_TRUE(b.is_empty(D1));
+}
+
+TEST(Board, PiecesOfBothColors) {
+    Board b = Board::initial();
+    EXPECT_EQ(b.pieces(PieceType::Rook), square_bb(A1) | square_bb(H1) | square_bb(A8) |
+                                             square_bb(H8));
+    EXPECT_EQ(b.pieces(PieceType::Pawn), kRank2 | kRank7);
 }
 
 // ── Bitboard consistency ────────────────────────────────────────────────────
@@ -0,0 +1,105 @@
+/// @file test_engine_pool.cpp
+/// Tests for engines sharing one transposition table.
+
+#include <chessie/engine_pool.hpp>
+#include <chessie/magic.hpp>
+
+#include <chrono>
+#include <gtest/gtest.h>
+#include <stdexcept>
+#include <thread>
+
+namespace chessie {
+namespace {
+
+class EnginePoolTest : public ::testing::Test {
+   protected:
+    static void SetUpTestSuite() { magic::init(); }
+};
+
+TEST_F(EnginePoolTest, StaysWithinBudget) {
+    EnginePool pool(8, 3);
+    EXPECT_EQ(pool.size(), 3U);
+    EXPECT_EQ(pool.budget_mb(), 8U);
+    EXPECT_LE(pool.memory_bytes(), 8U * 1024 * 1024);
+    EXPECT_GT(pool.tt().size_bytes(), 2U * 1024 * 1024);
+
+    pool.set_budget(6);
+    EXPECT_LE(pool.memory_bytes(), 6U * 1024 * 1024);
+    EXPECT_THROW(pool.set_budget(4), std::invalid_argument);
+
+    EXPECT_THROW(EnginePool(8, 0), std::invalid_argument);
+    EXPECT_THROW(EnginePool(1, 1), std::invalid_argument);
+    EXPECT_THROW((void)pool.engine(3), std::out_of_range);
+}
+
+TEST_F(EnginePoolTest, ContextsShareTheTable) {
+    SearchLimits limits;
+    limits.max_depth = 6;
+    const Position start = Position::initial();
+
+    Engine fresh(4);
+    Position pos = start;
+    const std::uint64_t cold_nodes = fresh.search(pos, limits).nodes;
+
+    EnginePool pool(8, 2);
+    pos = start;
+    (void)pool.engine(0).search(pos, limits);
+    pos = start;
+    const SearchResult warm = pool.engine(1).search(pos, limits);
+    EXPECT_LT(warm.nodes, cold_nodes);
+    EXPECT_FALSE(warm.best_move.is_null());
+}
+
+TEST_F(EnginePoolTest, ContextsSearchConcurrently) {
+    EnginePool pool(8, 2);
+    SearchLimits limits;
+    limits.max_depth = 5;
+    auto a = pool.engine(0).start_search(Position::initial(), limits);
+    auto b = pool.engine(1).start_search(
+        Position::from_fen("r1bqkb1r/pppp1ppp/2n2n2/4p3/2B1P3/5N2/PPPP1PPP/RNBQK2R w KQkq - 4 4"),
+        limits);
+    a->wait();
+    b->wait();
+    EXPECT_EQ(a->result().depth, 5);
+    EXPECT_EQ(b->result().depth, 5);
+    EXPECT_FALSE(a->result().best_move.is_null());
+    EXPECT_FALSE(b->result().best_move.is_null());
+}
+
+TEST_F(EnginePoolTest, TableChangesStopEveryContext) {
+    EnginePool pool(8, 2);
+    SearchLimits limits;
+    limits.max_depth = 64;
+
+    auto a = pool.engine(0).start_search(Position::initial(), limits);
+    auto b = pool.engine(1).start_search(Position::initial(), limits);
+    pool.set_budget(4);
+    EXPECT_TRUE(a->poll());
+    EXPECT_TRUE(b->poll());
+
+    // Through one context, the other context's search is stopped too.
+    a = pool.engine(0).start_search(Position::initial(), limits);
+    b = pool.engine(1).start_search(Position::initial(), limits);
+    pool.engine(0).clear_tt();
+    EXPECT_TRUE(a->poll());
+    EXPECT_TRUE(b->poll());
+
+    // A synchronous search on another thread is cancelled as well.
+    limits.time_limit_ms = 60'000;
+    SearchResult result;
+    std::thread t([&] {
+        Position pos = Position::initial();
+        result = pool.engine(1).search(pos, limits);
+    });
+    // Entries of the new search show that it is running.
+    while (pool.tt().hashfull() == 0) std::this_thread::yield();
+    const auto start = std::chrono::steady_clock::now();
+    pool.engine(0).set_tt_size(2);
+    t.join();
+    EXPECT_LT(std::chrono::steady_clock::now() - start, std::chrono::seconds(10));
+    EXPECT_LT(result.depth, 64);
+}
+
+}  // namespace
+}  // namespace chessie
@@ -0,0 +1,86 @@
+/// @file test_epd.cpp
+/// Tests for EPD parsing and the test-suite runner.
+
+#include <chessie/epd.hpp>
+#include <chessie/magic.hpp>
+
+#include <gtest/gtest.h>
+#include <sstream>
+#include <stdexcept>
+
+using namespace chessie;
+
+class EpdTest : public ::testing::Test {
+   public:
+    static void SetUpTestSuite() { magic::init(); }
+};
+
+TEST_F(EpdTest, ParsesOperations) {
+    epd::Record r = epd::parse_line(
+        "6k1/5ppp/8/8/8/8/8/R3K3 w Q - bm Ra8#; am Kd2 Ke2; id \"mate; in one\"; hmvc 3;");
+    EXPECT_EQ(r.fen, "6k1/5ppp/8/8/8/8/8/R3K3 w Q - 3 1");
+    EXPECT_EQ(r.id, "mate; in one");
+    ASSERT_EQ(r.best_moves.size(), 1U);
+    EXPECT_EQ(r.best_moves[0].uci(), "a1a8");
+    ASSERT_EQ(r.avoid_moves.size(), 2U);
+    EXPECT_EQ(r.avoid_moves[1].uci(), "e1e2");
+    ASSERT_EQ(r.operations.size(), 4U);
+    EXPECT_EQ(r.operations[0].first, "bm");
+    EXPECT_EQ(r.operations[3].second, "3");
+
+    EXPECT_TRUE(r.is_solution(r.best_moves[0]));
+    EXPECT_FALSE(r.is_solution(r.avoid_moves[0]));
+    EXPECT_FALSE(r.is_solution(Move{}));
+}
+
+TEST_F(EpdTest, AcceptsFenAndUciOperands) {
+    epd::Record fen = epd::parse_line("4k3/8/8/8/8/8/8/4K3 w - - 5 40");
+    EXPECT_EQ(fen.fen, "4k3/8/8/8/8/8/8/4K3 w - - 5 40");
+    EXPECT_TRUE(fen.operations.empty());
+    // Without bm or am, any move solves it.
+    EXPECT_TRUE(fen.is_solution(Move::from_uci("e1d1")));
+    EXPECT_FALSE(fen.is_solution(Move{}));
+
+    epd::Record uci = epd::parse_line("4k3/8/8/8/8/8/8/4K3 w - - am e1d1;");
+    ASSERT_EQ(uci.avoid_moves.size(), 1U);
+    EXPECT_TRUE(uci.is_solution(Move::from_uci("e1f1")));
+    EXPECT_FALSE(uci.is_solution(uci.avoid_moves[0]));
+}
+
+TEST_F(EpdTest, RejectsMalformedLines) {
+    EXPECT_THROW((void)epd::parse_line("4k3/8/8/8"), std::invalid_argument);
+    EXPECT_THROW((void)epd::parse_line("4k3/8/8/8/8/8/8/4K3 w - - bm e4;"), std::invalid_argument);
+
+    std::istringstream in("# comment\n\n4k3/8/8/8/8/8/8/4K3 w - - id \"a\";\n");
+    EXPECT_EQ(epd::read(in).size(), 1U);
+}
+
+TEST_F(EpdTest, RunsSuiteAcrossThreads) {
+    std::istringstream in(
+        "6k1/5ppp/8/8/8/8/8/R3K3 w - - bm Ra8#; id \"mate\";\n"
+        "4k3/8/8/8/8/8/3q4/4K3 w - - bm Kxd2; id \"capture\";\n"
+        "4k3/8/8/8/8/8/8/4K2R w K - bm Ke2; id \"unsolved\";\n");
+    const std::vector<epd::Record> records = epd::read(in);
+
+    epd::RunConfig config;
+    config.limits.max_depth = 4;
+    config.threads = 2;
+    config.tt_mb = 1;
+    int callbacks = 0;
+    const auto results =
+        epd::run_suite(records, config, [&](const epd::Record&, const epd::PositionResult&) {
+            ++callbacks;
+        });
+
+    ASSERT_EQ(results.size(), 3U);
+    EXPECT_EQ(callbacks, 3);
+    for (std::size_t i = 0; i < results.size(); ++i) EXPECT_EQ(results[i].index, i);
+
+    EXPECT_TRUE(results[0].solved);
+    EXPECT_EQ(results[0].solution_depth, 1);
+    EXPECT_GT(results[0].nodes_to_solution, 0U);
+    EXPECT_LE(results[0].nodes_to_solution, results[0].nodes);
+    EXPECT_TRUE(results[1].solved);
+    EXPECT_FALSE(results[2].solved);
+    EXPECT_EQ(results[2].solution_depth, 0);
+}
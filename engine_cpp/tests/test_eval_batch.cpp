@@ -0,0 +1,87 @@
+/// @file test_eval_batch.cpp
+/// Tests for batched bit-plane evaluation.
+
+#include <chessie/eval_batch.hpp>
+#include <chessie/evaluation.hpp>
+#include <chessie/magic.hpp>
+#include <chessie/movegen.hpp>
+#include <chessie/position.hpp>
+
+#include <gtest/gtest.h>
+#include <random>
+#include <stdexcept>
+#include <vector>
+
+using namespace chessie;
+
+class EvalBatchTest : public ::testing::Test {
+   public:
+    static void SetUpTestSuite() { magic::init(); }
+
+    /// Positions from a few seeded random games (odd count to exercise the tail).
+    static std::vector<Position> random_positions() {
+        std::vector<Position> positions;
+        std::mt19937 rng(12345);
+        for (int game = 0; game < 8; ++game) {
+            Position pos = Position::initial();
+            for (int ply = 0; ply < 120; ++ply) {
+                MoveList moves = movegen::legal(pos);
+                if (moves.size() == 0)
+                    break;
+                auto index = static_cast<int>(rng() % static_cast<unsigned>(moves.size()));
+                pos.make_move(moves[index]);
+                positions.push_back(pos);
+            }
+        }
+        if (positions.size() % 2 == 0)
+            positions.pop_back();
+        return positions;
+    }
+};
+
+TEST_F(EvalBatchTest, MatchesScalarEvaluation) {
+    std::vector<Position> positions = random_positions();
+    positions.push_back(Position::from_fen("4k3/8/8/8/3Q4/8/8/4K3 b - - 0 1"));
+
+    eval::PositionBatch batch(positions.size());
+    for (const Position& pos : positions) batch.add(pos);
+    ASSERT_EQ(batch.size(), positions.size());
+
+    std::vector<int> scores(batch.size());
+    eval::evaluate_batch(batch, scores);
+    for (std::size_t i = 0; i < positions.size(); ++i) {
+        EXPECT_EQ(scores[i], eval::evaluate(positions[i])) << positions[i].to_fen();
+    }
+}
+
+TEST_F(EvalBatchTest, MatchesCustomParams) {
+    // Negative and wide-ranging weights exercise the base offset and high planes.
+    eval::Params params = eval::default_params();
+    params.pst(1, D4) = {-700, 900};
+    params.pst(4, A8) = {12345, -3};
+    params.piece_value(0) = {-50, 2000};
+
+    std::vector<Position> positions = random_positions();
+    eval::PositionBatch batch;
+    for (const Position& pos : positions) batch.add(pos);
+
+    std::vector<int> scores(batch.size());
+    eval::BatchEvaluator(params).evaluate(batch, scores);
+    for (std::size_t i = 0; i < positions.size(); ++i) {
+        EXPECT_EQ(scores[i], eval::evaluate(positions[i], params)) << positions[i].to_fen();
+    }
+}
+
+TEST_F(EvalBatchTest, ClearAndSizeMismatch) {
+    eval::PositionBatch batch;
+    batch.add(Position::initial());
+    batch.add(Position::initial());
+
+    std::vector<int> scores(1);
+    EXPECT_THROW(eval::evaluate_batch(batch, scores), std::invalid_argument);
+
+    batch.clear();
+    EXPECT_TRUE(batch.empty());
+    std::vector<int> none;
+    EXPECT_NO_THROW(eval::evaluate_batch(batch, none));
+}
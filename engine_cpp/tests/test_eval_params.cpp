@@ -0,0 +1,133 @@
+/// @file test_eval_params.cpp
+/// Tests for runtime-loadable evaluation parameters.
+
+#include <chessie/engine.hpp>
+#include <chessie/evaluation.hpp>
+#include <chessie/magic.hpp>
+#include <chessie/position.hpp>
+
+#include <gtest/gtest.h>
+#include <sstream>
+#include <stdexcept>
+
+using namespace chessie;
+
+class EvalParamsTest : public ::testing::Test {
+   public:
+    static void SetUpTestSuite() { magic::init(); }
+    void TearDown() override { eval::set_params(eval::default_params()); }
+};
+
+// ── Naming ──────────────────────────────────────────────────────────────────
+
+TEST_F(EvalParamsTest, TermNamesRoundTrip) {
+    for (int i = 0; i < eval::Params::kNumTerms; ++i) {
+        EXPECT_EQ(eval::term_index(eval::term_name(i)), i);
+    }
+    EXPECT_EQ(eval::term_name(eval::Params::kPieceValueOffset + 1), "piece_value.knight");
+    EXPECT_EQ(eval::term_index("pst.rook.e7"), eval::Params::kPstOffset + 3 * 64 + E7);
+    EXPECT_EQ(eval::term_index("mobility.bishop.5"), eval::Params::mobility_index(2, 5));
+    EXPECT_EQ(eval::term_name(eval::Params::kKingAttackOffset + 12), "king_attack.12");
+    EXPECT_EQ(eval::term_index("no.such.term"), -1);
+}
+
+// ── Text I/O ────────────────────────────────────────────────────────────────
+
+TEST_F(EvalParamsTest, SaveLoadRoundTrip) {
+    std::stringstream ss;
+    eval::save_params(ss, eval::default_params());
+
+    eval::Params loaded{};
+    eval::load_params(ss, loaded);
+    EXPECT_EQ(loaded, eval::default_params());
+}
+
+TEST_F(EvalParamsTest, LoadOverlaysMentionedTermsOnly) {
+    std::istringstream in("# comment\n\npiece_value.queen 2000 1900\n");
+    eval::Params p = eval::default_params();
+    eval::load_params(in, p);
+    EXPECT_EQ(p.piece_value(4).mg, 2000);
+    EXPECT_EQ(p.piece_value(4).eg, 1900);
+    EXPECT_EQ(p.piece_value(3), eval::default_params().piece_value(3));
+}
+
+TEST_F(EvalParamsTest, LoadRejectsMalformedLines) {
+    eval::Params p{};
+    std::istringstream unknown("pst.dragon.a1 1 2\n");
+    EXPECT_THROW(eval::load_params(unknown, p), std::invalid_argument);
+    std::istringstream bad_weight("piece_value.pawn ten 2\n");
+    EXPECT_THROW(eval::load_params(bad_weight, p), std::invalid_argument);
+}
+
+TEST_F(EvalParamsTest, ExportContainsConstexprTables) {
+    std::ostringstream out;
+    eval::export_cpp(out, eval::default_params());
+    const std::string text = out.str();
+    EXPECT_NE(text.find("constexpr int kPieceValueMG[] = {"), std::string::npos);
+    EXPECT_NE(text.find("constexpr int kMgPst[6][64] = {"), std::string::npos);
+    EXPECT_NE(text.find("constexpr int kEgPst[6][64] = {"), std::string::npos);
+    EXPECT_NE(text.find("constexpr Score kMobility[] = {"), std::string::npos);
+    EXPECT_NE(text.find("constexpr Score kKingAttack[] = {"), std::string::npos);
+    EXPECT_NE(text.find("1025,"), std::string::npos);
+}
+
+// ── Active parameter set ────────────────────────────────────────────────────
+
+TEST_F(EvalParamsTest, SetParamsChangesEvaluation) {
+    auto pos = Position::from_fen("4k3/8/8/8/3Q4/8/8/4K3 w - - 0 1");
+    int before = eval::evaluate(pos);
+
+    eval::Params p = eval::default_params();
+    p.piece_value(4).mg += 100;
+    p.piece_value(4).eg += 100;
+    eval::set_params(p);
+    EXPECT_EQ(eval::evaluate(pos), before + 100);
+    EXPECT_EQ(eval::evaluate(pos, eval::default_params()), before);
+}
+
+TEST_F(EvalParamsTest, SetParamsLeavesSnapshotsAlone) {
+    const auto snapshot = eval::params();
+    eval::Params p = eval::default_params();
+    p.piece_value(4).mg += 100;
+    eval::set_params(p);
+    EXPECT_EQ(*snapshot, eval::default_params());
+    EXPECT_EQ(*eval::params(), p);
+
+    // A running search keeps the set it started with.
+    Engine engine(1);
+    SearchLimits limits;
+    limits.max_depth = 6;
+    auto handle = engine.start_search(Position::initial(), limits);
+    for (int i = 0; i < 50; ++i) {
+        p.piece_value(4).mg += 1;
+        eval::set_params(p);
+    }
+    handle->wait();
+    EXPECT_FALSE(handle->result().best_move.is_null());
+}
+
+TEST_F(EvalParamsTest, TraceReproducesEvaluation) {
+    const char* fens[] = {
+        "r1bqkbnr/pppp1ppp/2n5/4p3/4P3/5N2/PPPP1PPP/RNBQKB1R w KQkq - 2 3",
+        "4k3/8/8/3q4/8/8/4P3/4K3 b - - 0 1",
+        "8/8/8/3k4/8/8/4P3/4K3 w - - 0 1",
+        "6k1/5ppp/8/6NQ/8/8/5PPP/6K1 b - - 0 1",  // king attack
+    };
+    const eval::Params& p = eval::default_params();
+    for (const char* fen : fens) {
+        auto pos = Position::from_fen(fen);
+        eval::Trace tr;
+        eval::trace(pos, p, tr);
+
+        long mg = 0;
+        long eg = 0;
+        for (const auto& t : tr.terms) {
+            mg += t.coef * p.terms[t.index].mg;
+            eg += t.coef * p.terms[t.index].eg;
+        }
+        long white = (mg * tr.phase + eg * (eval::kTotalPhase - tr.phase)) / eval::kTotalPhase;
+        int expected = pos.side_to_move() == Color::White ? eval::evaluate(pos, p)
+                                                          : -eval::evaluate(pos, p);
+        EXPECT_EQ(white, expected) << fen;
+    }
+}
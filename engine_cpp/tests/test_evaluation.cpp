@@ -138,3 +138,52 @@ TEST_F(EvalTest, BishopWorthMoreThanPawn) {
     auto pos_p = Position::from_fen("4k3/8/8/8/3P4/8/8/4K3 w - - 0 1");
     EXPECT_GT(eval::evaluate(pos_b), eval::evaluate(pos_p));
 }
+
+// ── Mobility and king safety ────────────────────────────────────────────────
+
+TEST_F(EvalTest, KnightMobilityCountsSafeSquares) {
+    // Knight on d4 reaches 8 squares; b3 holds a white pawn and c6 / e6 are
+    // covered by the black pawn on d7.
+    auto pos = Position::from_fen("k7/3p4/8/8/3N4/1P6/8/K7 w - - 0 1");
+    PieceBitboards pieces = piece_bitboards(pos.board());
+    AttackMap attacks = compute_attacks(pos.board());
+    const eval::Params& p = eval::default_params();
+    eval::Score score = eval::attack_score(pieces, attacks, p);
+    EXPECT_EQ(score, p.mobility(1, 5));
+}
+
+TEST_F(EvalTest, KingAttackNeedsTwoAttackers) {
+    const eval::Params& p = eval::default_params();
+    auto score_of = [&](const char* fen) {
+        auto pos = Position::from_fen(fen);
+        return eval::attack_score(piece_bitboards(pos.board()), compute_attacks(pos.board()), p);
+    };
+    // Queen alone vs queen + knight against the g8 king; the king-attack
+    // penalty applies only with two attackers.
+    eval::Score queen = score_of("6k1/5ppp/8/7Q/8/8/5PPP/6K1 w - - 0 1");
+    eval::Score both = score_of("6k1/5ppp/8/6NQ/8/8/5PPP/6K1 w - - 0 1");
+    EXPECT_GT(both.mg - queen.mg, p.mobility(1, 6).mg);
+}
+
+// ── Lazy evaluation ─────────────────────────────────────────────────────────
+
+TEST_F(EvalTest, LazyEvalMatchesFullInsideWindow) {
+    auto pos = Position::from_fen("6k1/5ppp/8/6NQ/8/8/5PPP/6K1 b - - 0 1");
+    eval::EvalStats stats;
+    int full = eval::evaluate(pos);
+    EXPECT_EQ(eval::evaluate(pos, full - 1, full + 1, &stats), full);
+    EXPECT_EQ(eval::evaluate(pos, -1'000'000, 1'000'000, &stats), full);
+    EXPECT_EQ(stats.full, 2u);
+    EXPECT_EQ(stats.lazy, 0u);
+}
+
+TEST_F(EvalTest, LazyEvalExitsFarOutsideWindow) {
+    // White is a queen up: far above any small window around zero.
+    auto pos = Position::from_fen("4k3/8/8/8/3Q4/8/8/4K3 w - - 0 1");
+    eval::EvalStats stats;
+    int lazy = eval::evaluate(pos, -50, 50, &stats);
+    EXPECT_EQ(stats.lazy, 1u);
+    EXPECT_EQ(stats.full, 0u);
+    EXPECT_GE(lazy - eval::kLazyMargin, 50);
+    EXPECT_NEAR(lazy, eval::evaluate(pos), eval::kLazyMargin);
+}
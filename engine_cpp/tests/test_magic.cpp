@@ -5,6 +5,21 @@
 
 using namespace chessie;
 
+namespace {
+
+Bitboard slide(Square sq, Bitboard occ, int df, int dr) {
+    Bitboard attacks = kEmptyBB;
+    for (int f = file_of(sq) + df, r = rank_of(sq) + dr; f >= 0 && f <= 7 && r >= 0 && r <= 7;
+         f += df, r += dr) {
+        set_bit(attacks, make_square(f, r));
+        if (test_bit(occ, make_square(f, r)))
+            break;
+    }
+    return attacks;
+}
+
+}  // namespace
+
 class MagicTest : public ::testing::Test {
    protected:
     static void SetUpTestSuite() { magic::init(); }
@@ -115,3 +130,25 @@ TEST_F(MagicTest, RookAttacksDontOverlapOwnSquare) {
         EXPECT_FALSE(test_bit(attacks, static_cast<Square>(sq)));
     }
 }
+
+TEST_F(MagicTest, MatchesRayTracingOnRandomOccupancies) {
+    // A full board plus sparse random occupancies on every square.
+    std::uint64_t state = 0x9E3779B97F4A7C15ULL;
+    auto next = [&]() {
+        state ^= state << 13;
+        state ^= state >> 7;
+        state ^= state << 17;
+        return state;
+    };
+    for (int sq = 0; sq < 64; ++sq) {
+        const auto s = static_cast<Square>(sq);
+        for (int i = 0; i < 256; ++i) {
+            const Bitboard occ = i == 0 ? kFullBB : next() & next();
+            EXPECT_EQ(magic::rook_attacks(s, occ), slide(s, occ, 1, 0) | slide(s, occ, -1, 0) |
+                                                       slide(s, occ, 0, 1) | slide(s, occ, 0, -1));
+            EXPECT_EQ(magic::bishop_attacks(s, occ), slide(s, occ, 1, 1) | slide(s, occ, 1, -1) |
+                                                         slide(s, occ, -1, 1) |
+                                                         slide(s, occ, -1, -1));
+        }
+    }
+}
@@ -0,0 +1,162 @@
+/// @file test_match.cpp
+/// Tests for match play, PGN I/O and SPRT statistics.
+
+#include <chessie/engine.hpp>
+#include <chessie/magic.hpp>
+#include <chessie/match.hpp>
+
+#include <cmath>
+#include <gtest/gtest.h>
+#include <sstream>
+#include <stdexcept>
+
+using namespace chessie;
+
+class MatchTest : public ::testing::Test {
+   public:
+    static void SetUpTestSuite() { magic::init(); }
+
+    static match::EngineConfig shallow(std::string name, int depth) {
+        match::EngineConfig config;
+        config.name = std::move(name);
+        config.tt_mb = 1;
+        config.limits.max_depth = depth;
+        return config;
+    }
+};
+
+// ── Statistics ──────────────────────────────────────────────────────────────
+
+TEST_F(MatchTest, EloConversions) {
+    EXPECT_DOUBLE_EQ(match::expected_score(0.0), 0.5);
+    EXPECT_NEAR(match::expected_score(400.0), 10.0 / 11.0, 1e-12);
+    EXPECT_NEAR(match::elo_from_score(match::expected_score(123.0)), 123.0, 1e-9);
+    EXPECT_NEAR(match::elo_from_score(0.25), -match::elo_from_score(0.75), 1e-9);
+}
+
+TEST_F(MatchTest, SprtLlrAndDecision) {
+    // No variance yet: no evidence either way.
+    EXPECT_EQ(match::sprt_llr({5, 0, 0}, 0.0, 5.0), 0.0);
+
+    // W/D/L = 600/800/400 over 1800 games.
+    match::Tally tally{600, 800, 400};
+    const double n = 1800.0;
+    const double s = (600 + 800 / 2.0) / n;
+    const double var = (600 / n + 800 / n / 4.0 - s * s) / n;
+    const double s0 = match::expected_score(0.0);
+    const double s1 = match::expected_score(5.0);
+    const double llr = match::sprt_llr(tally, 0.0, 5.0);
+    EXPECT_NEAR(llr, (s1 - s0) * (2 * s - s0 - s1) / (2 * var), 1e-9);
+
+    match::SprtConfig sprt;
+    EXPECT_EQ(match::sprt_decision(llr, sprt), match::SprtDecision::AcceptH1);
+    EXPECT_EQ(match::sprt_decision(0.0, sprt), match::SprtDecision::Continue);
+    EXPECT_EQ(match::sprt_decision(-3.0, sprt), match::SprtDecision::AcceptH0);
+    EXPECT_LT(match::sprt_llr({400, 800, 600}, 0.0, 5.0), 0.0);
+}
+
+TEST_F(MatchTest, EloErrorShrinksWithGames) {
+    const double small = match::elo_error_95({30, 40, 30});
+    const double large = match::elo_error_95({300, 400, 300});
+    EXPECT_GT(small, 0.0);
+    EXPECT_NEAR(small / large, std::sqrt(10.0), 0.1);
+}
+
+// ── Openings ────────────────────────────────────────────────────────────────
+
+TEST_F(MatchTest, ReadsEpdOpenings) {
+    std::istringstream in(
+        "# comment\n"
+        "rnbqkbnr/pppppppp/8/8/4P3/8/PPPP1PPP/RNBQKBNR b KQkq e3 bm e5; id \"a\";\n"
+        "\n"
+        "4k3/8/8/8/8/8/8/4K3 w - - 5 40\n");
+    std::vector<std::string> openings = match::read_openings(in);
+    ASSERT_EQ(openings.size(), 2U);
+    EXPECT_EQ(openings[0], "rnbqkbnr/pppppppp/8/8/4P3/8/PPPP1PPP/RNBQKBNR b KQkq e3 0 1");
+    EXPECT_EQ(openings[1], "4k3/8/8/8/8/8/8/4K3 w - - 5 40");
+}
+
+TEST_F(MatchTest, ReadsPgnOpenings) {
+    std::istringstream in(
+        "[Event \"?\"]\n"
+        "[Result \"*\"]\n"
+        "\n"
+        "1. e4 {main} e5 (1... c5 2. Nf3) 2. Nf3 $1 Nc6 *\n"
+        "\n"
+        "[Event \"?\"]\n"
+        "[FEN \"4k3/8/8/8/8/8/4P3/4K3 w - - 0 1\"]\n"
+        "\n"
+        "1. e4 Kd7 *\n");
+    std::vector<std::string> openings = match::read_openings(in);
+    ASSERT_EQ(openings.size(), 2U);
+    EXPECT_EQ(openings[0], "r1bqkbnr/pppp1ppp/2n5/4p3/4P3/5N2/PPPP1PPP/RNBQKB1R w KQkq - 2 3");
+    EXPECT_EQ(openings[1], "8/3k4/8/8/4P3/8/8/4K3 w - - 1 2");
+
+    std::istringstream bad("[Event \"?\"]\n\n1. e5 *\n");
+    EXPECT_THROW((void)match::read_openings(bad), std::invalid_argument);
+}
+
+// ── Games ───────────────────────────────────────────────────────────────────
+
+TEST_F(MatchTest, PlaysToCheckmate) {
+    Engine white(1);
+    Engine black(1);
+    match::GameRecord game = match::play_game(white, shallow("w", 3), black, shallow("b", 3),
+                                              "6k1/5ppp/8/8/8/8/8/R3K3 w - - 0 1", 50);
+    EXPECT_EQ(game.outcome, match::Outcome::WhiteWins);
+    EXPECT_EQ(game.termination, "checkmate");
+    ASSERT_EQ(game.san.size(), 1U);
+    EXPECT_EQ(game.san[0].back(), '#');
+}
+
+TEST_F(MatchTest, AdjudicatesDraws) {
+    Engine white(1);
+    Engine black(1);
+    match::GameRecord bare = match::play_game(white, shallow("w", 2), black, shallow("b", 2),
+                                              "4k3/8/8/8/8/8/8/4K3 w - - 0 1", 50);
+    EXPECT_EQ(bare.outcome, match::Outcome::Draw);
+    EXPECT_EQ(bare.termination, "insufficient material");
+
+    match::GameRecord capped = match::play_game(white, shallow("w", 1), black, shallow("b", 1),
+                                                kStartingFen, 6);
+    EXPECT_EQ(capped.san.size(), 6U);
+    EXPECT_EQ(capped.outcome, match::Outcome::Draw);
+}
+
+TEST_F(MatchTest, WritesPgn) {
+    match::GameRecord game;
+    game.round = 3;
+    game.white = "A";
+    game.black = "B";
+    game.start_fen = "rnbqkbnr/pppppppp/8/8/4P3/8/PPPP1PPP/RNBQKBNR b KQkq e3 0 1";
+    game.san = {"e5", "Nf3", "Nc6"};
+    game.outcome = match::Outcome::BlackWins;
+    game.termination = "time forfeit";
+
+    const std::string pgn = match::to_pgn(game);
+    EXPECT_NE(pgn.find("[Round \"3\"]\n[White \"A\"]\n[Black \"B\"]\n[Result \"0-1\"]\n"),
+              std::string::npos);
+    EXPECT_NE(pgn.find("[SetUp \"1\"]\n[FEN \"" + game.start_fen + "\"]\n"), std::string::npos);
+    EXPECT_NE(pgn.find("[PlyCount \"3\"]"), std::string::npos);
+    EXPECT_NE(pgn.find("\n1... e5 2. Nf3 Nc6 0-1\n\n"), std::string::npos) << pgn;
+}
+
+TEST_F(MatchTest, RunsConcurrentMatch) {
+    match::MatchConfig config;
+    config.first = shallow("deep", 2);
+    config.second = shallow("shallow", 1);
+    config.games = 4;
+    config.concurrency = 2;
+    config.max_plies = 40;
+
+    int callbacks = 0;
+    match::MatchResult result =
+        match::run_match(config, [&](const match::GameRecord& game, const match::Tally& tally) {
+            ++callbacks;
+            EXPECT_EQ(tally.games(), callbacks);
+            EXPECT_EQ(game.first_is_white, game.round % 2 == 1);
+        });
+    EXPECT_EQ(callbacks, 4);
+    EXPECT_EQ(result.tally.games(), 4);
+    EXPECT_EQ(result.decision, match::SprtDecision::Continue);
+}
@@ -49,6 +49,17 @@ TEST(Piece, Equality) {
 
 TEST(Piece, NoPieceSentinel) {
     EXPECT_EQ(kNoPiece.type, PieceType::None);
+    EXPECT_EQ(kNoPiece.code(), 0);
+}
+
+TEST(Piece, CodeRoundTrip) {
+    for (Color c : {Color::White, Color::Black}) {
+        for (int t = 1; t <= kNumPieceTypes; ++t) {
+            const Piece p{c, static_cast<PieceType>(t)};
+            EXPECT_EQ(p.code(), color_index(c) << 3 | t);
+            EXPECT_EQ(Piece::from_code(p.code()), p);
+        }
+    }
 }
 
 }  // namespace chessie
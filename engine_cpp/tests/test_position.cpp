@@ -1,6 +1,8 @@
 #include <chessie/magic.hpp>
+#include <chessie/movegen.hpp>
 #include <chessie/position.hpp>
 
+#include <algorithm>
 #include <gtest/gtest.h>
 
 using namespace chessie;
@@ -387,3 +389,181 @@ TEST_F(PositionTest, MultiMoveUnmake) {
     EXPECT_EQ(pos.to_fen(), original_fen);
     EXPECT_EQ(pos.key(), original_key);
 }
+
+// ── Draw rules ──────────────────────────────────────────────────────────────
+
+TEST_F(PositionTest, InsufficientMaterial) {
+    EXPECT_TRUE(Position::from_fen("4k3/8/8/8/8/8/8/4K3 w - - 0 1").is_insufficient_material());
+    EXPECT_TRUE(Position::from_fen("4k3/8/8/8/8/8/8/4KN2 w - - 0 1").is_insufficient_material());
+    // Same-coloured bishops (c1 and f8 are both dark squares).
+    EXPECT_TRUE(Position::from_fen("5b2/4k3/8/8/8/8/8/2B1K3 w - - 0 1").is_insufficient_material());
+    EXPECT_FALSE(
+        Position::from_fen("2b1k3/8/8/8/8/8/8/2B1K3 w - - 0 1").is_insufficient_material());
+    EXPECT_FALSE(Position::from_fen("4k3/8/8/8/8/8/8/4KR2 w - - 0 1").is_insufficient_material());
+    EXPECT_FALSE(Position::initial().is_insufficient_material());
+}
+
+// ── Gives check ─────────────────────────────────────────────────────────────
+
+namespace {
+
+/// Compare gives_check with make_move + is_in_check over a small tree.
+int count_check_mismatches(Position& pos, int depth) {
+    int mismatches = 0;
+    const CheckInfo ci = pos.check_info();
+    for (const Move& m : movegen::legal(pos)) {
+        const bool predicted = pos.gives_check(m, ci);
+        pos.make_move(m);
+        if (predicted != pos.is_in_check())
+            ++mismatches;
+        if (depth > 1)
+            mismatches += count_check_mismatches(pos, depth - 1);
+        pos.unmake_move(m);
+    }
+    return mismatches;
+}
+
+}  // namespace
+
+TEST_F(PositionTest, GivesCheckMatchesMakeMove) {
+    const char* fens[] = {
+        "r3k2r/p1ppqpb1/bn2pnp1/3PN3/1p2P3/2N2Q1p/PPPBBPPP/R3K2R w KQkq - 0 1",
+        "8/2p5/3p4/KP5r/1R3p1k/8/4P1P1/8 w - - 0 1",
+        "r3k2r/Pppp1ppp/1b3nbN/nP6/BBP1P3/q4N2/Pp1P2PP/R2Q1RK1 w kq - 0 1",
+        "rnbq1k1r/pp1Pbppp/2p5/8/2B5/8/PPP1NnPP/RNBQK2R w KQ - 1 8",
+    };
+    for (const char* fen : fens) {
+        Position pos = Position::from_fen(fen);
+        EXPECT_EQ(count_check_mismatches(pos, 3), 0) << fen;
+    }
+}
+
+TEST_F(PositionTest, GivesCheckSpecialMoves) {
+    // Discovered check: the bishop leaves the rook's file.
+    Position disc = Position::from_fen("4k3/8/8/8/4B3/8/8/4R1K1 w - - 0 1");
+    EXPECT_TRUE(disc.gives_check({E4, B7}));
+    EXPECT_FALSE(disc.gives_check({E1, D1}));
+
+    // Castling checks with the rook.
+    Position castle = Position::from_fen("5k2/8/8/8/8/8/8/4K2R w K - 0 1");
+    EXPECT_TRUE(castle.gives_check({E1, G1, MoveFlag::CastleKingside}));
+
+    // En passant removes the pawn shielding the king from the rook.
+    Position ep = Position::from_fen("8/8/8/1k1pP2R/8/8/8/4K3 w - d6 0 1");
+    EXPECT_TRUE(ep.gives_check({E5, D6, MoveFlag::EnPassant}));
+
+    // A promoted rook checks through the square the pawn left.
+    Position promo = Position::from_fen("8/4P3/8/8/8/8/8/K3k3 w - - 0 1");
+    EXPECT_TRUE(promo.gives_check({E7, E8, MoveFlag::Promotion, PieceType::Rook}));
+    EXPECT_FALSE(promo.gives_check({E7, E8, MoveFlag::Promotion, PieceType::Knight}));
+}
+
+
+// ── Cached check state ──────────────────────────────────────────────────────
+
+TEST_F(PositionTest, CachedCheckState) {
+    // White's e2 knight is pinned by the e8 rook.
+    Position pos = Position::from_fen("4r1k1/8/8/1B6/8/8/4N3/4K3 b - - 0 1");
+    EXPECT_FALSE(pos.is_in_check());
+    EXPECT_EQ(pos.blockers_for_king(Color::White), square_bb(E2));
+
+    pos.make_move({G8, F7});
+    EXPECT_EQ(pos.pinned(), square_bb(E2));
+    pos.make_move({B5, E8});  // Bxe8+
+    EXPECT_EQ(pos.checkers(), square_bb(E8));
+    EXPECT_EQ(pos.blockers_for_king(Color::White), kEmptyBB);
+    pos.unmake_move({B5, E8});
+    pos.unmake_move({G8, F7});
+    EXPECT_EQ(pos.checkers(), kEmptyBB);
+    EXPECT_EQ(pos.blockers_for_king(Color::White), square_bb(E2));
+
+    // A null move keeps the shields and clears the checkers.
+    pos.make_null_move();
+    EXPECT_EQ(pos.blockers_for_king(Color::White), square_bb(E2));
+    EXPECT_FALSE(pos.is_in_check());
+    pos.unmake_null_move();
+}
+
+TEST_F(PositionTest, CachedCheckersMatchAttackTest) {
+    Position pos =
+        Position::from_fen("r3k2r/p1ppqpb1/bn2pnp1/3PN3/1p2P3/2N2Q1p/PPPBBPPP/R3K2R w KQkq - 0 1");
+    for (const Move& m : movegen::legal(pos)) {
+        pos.make_move(m);
+        for (const Move& reply : movegen::legal(pos)) {
+            pos.make_move(reply);
+            const Color us = pos.side_to_move();
+            EXPECT_EQ(pos.is_in_check(),
+                      pos.is_square_attacked(pos.board().king_square(us), opposite(us)));
+            pos.unmake_move(reply);
+        }
+        pos.unmake_move(m);
+    }
+}
+
+// ── Move validation ─────────────────────────────────────────────────────────
+
+namespace {
+
+/// Check is_pseudo_legal against movegen for every encodable move, and
+/// is_legal against make_move, over a small tree.
+int count_validation_mismatches(Position& pos, int depth) {
+    const MoveList pseudo = movegen::pseudo_legal(pos);
+    auto generated = [&](const Move& m) {
+        return std::find(pseudo.begin(), pseudo.end(), m) != pseudo.end();
+    };
+
+    int mismatches = 0;
+    constexpr MoveFlag kFlags[] = {MoveFlag::Normal,         MoveFlag::DoublePawn,
+                                   MoveFlag::EnPassant,      MoveFlag::CastleKingside,
+                                   MoveFlag::CastleQueenside};
+    for (int from = 0; from < 64; ++from) {
+        for (int to = 0; to < 64; ++to) {
+            const auto f = static_cast<Square>(from);
+            const auto t = static_cast<Square>(to);
+            for (MoveFlag flag : kFlags) {
+                const Move m{f, t, flag, PieceType::None};
+                mismatches += pos.is_pseudo_legal(m) != generated(m);
+            }
+            for (int p = 0; p <= static_cast<int>(PieceType::King); ++p) {
+                const Move m{f, t, MoveFlag::Promotion, static_cast<PieceType>(p)};
+                mismatches += pos.is_pseudo_legal(m) != generated(m);
+            }
+        }
+    }
+
+    const Color us = pos.side_to_move();
+    for (const Move& m : pseudo) {
+        const bool predicted = pos.is_legal(m);
+        pos.make_move(m);
+        mismatches += predicted == pos.is_in_check(us);
+        if (predicted && depth > 1)
+            mismatches += count_validation_mismatches(pos, depth - 1);
+        pos.unmake_move(m);
+    }
+    return mismatches;
+}
+
+}  // namespace
+
+TEST_F(PositionTest, MoveValidationMatchesMovegen) {
+    const char* fens[] = {
+        "r3k2r/p1ppqpb1/bn2pnp1/3PN3/1p2P3/2N2Q1p/PPPBBPPP/R3K2R w KQkq - 0 1",
+        "8/2p5/3p4/KP5r/1R3p1k/8/4P1P1/8 w - - 0 1",
+        "r3k2r/Pppp1ppp/1b3nbN/nP6/BBP1P3/q4N2/Pp1P2PP/R2Q1RK1 w kq - 0 1",
+        "8/8/8/1k1pP2R/8/8/8/4K3 w - d6 0 1",
+    };
+    for (const char* fen : fens) {
+        Position pos = Position::from_fen(fen);
+        EXPECT_EQ(count_validation_mismatches(pos, 2), 0) << fen;
+    }
+}
+
+TEST_F(PositionTest, RejectsMovesFromOtherPositions) {
+    Position pos = Position::initial();
+    EXPECT_TRUE(pos.is_pseudo_legal({E2, E4, MoveFlag::DoublePawn}));
+    EXPECT_FALSE(pos.is_pseudo_legal({E2, E4}));                         // wrong flag
+    EXPECT_FALSE(pos.is_pseudo_legal({E7, E5, MoveFlag::DoublePawn}));  // not our pawn
+    EXPECT_FALSE(pos.is_pseudo_legal({F1, C4}));                         // blocked bishop
+    EXPECT_FALSE(pos.is_pseudo_legal({E1, G1, MoveFlag::CastleKingside}));
+    EXPECT_FALSE(pos.is_pseudo_legal(kNullMove));
+}
@@ -0,0 +1,95 @@
+/// @file test_san.cpp
+/// Tests for SAN formatting and parsing.
+
+#include <chessie/magic.hpp>
+#include <chessie/movegen.hpp>
+#include <chessie/position.hpp>
+#include <chessie/san.hpp>
+
+#include <gtest/gtest.h>
+#include <random>
+#include <stdexcept>
+
+using namespace chessie;
+
+class SanTest : public ::testing::Test {
+   public:
+    static void SetUpTestSuite() { magic::init(); }
+
+    static std::string format_uci(std::string_view fen, std::string_view uci) {
+        Position pos = Position::from_fen(fen);
+        for (const Move& m : movegen::legal(pos)) {
+            if (m.uci() == uci)
+                return san::format(pos, m);
+        }
+        return "?";
+    }
+};
+
+TEST_F(SanTest, FormatsBasicMoves) {
+    EXPECT_EQ(format_uci(kStartingFen, "e2e4"), "e4");
+    EXPECT_EQ(format_uci(kStartingFen, "g1f3"), "Nf3");
+    EXPECT_EQ(format_uci("r1bqkbnr/pppp1ppp/2n5/4p3/3PP3/8/PPP2PPP/RNBQKBNR w KQkq - 1 3", "d4e5"),
+              "dxe5");
+    EXPECT_EQ(format_uci("4k3/8/8/8/8/8/8/4K2R w K - 0 1", "e1g1"), "O-O");
+    EXPECT_EQ(format_uci("r3k3/8/8/8/8/8/8/4K3 b q - 0 1", "e8c8"), "O-O-O");
+    EXPECT_EQ(format_uci("4k3/8/8/3pP3/8/8/8/4K3 w - d6 0 1", "e5d6"), "exd6");
+}
+
+TEST_F(SanTest, FormatsPromotionAndCheckSuffixes) {
+    EXPECT_EQ(format_uci("7k/4P3/8/8/8/8/8/4K3 w - - 0 1", "e7e8q"), "e8=Q+");
+    EXPECT_EQ(format_uci("7k/4P3/8/8/8/8/8/4K3 w - - 0 1", "e7e8n"), "e8=N");
+    EXPECT_EQ(format_uci("6k1/5ppp/8/8/8/8/8/R3K3 w - - 0 1", "a1a8"), "Ra8#");
+}
+
+TEST_F(SanTest, Disambiguates) {
+    // Knights on b1 and f1 both reach d2: file disambiguation.
+    EXPECT_EQ(format_uci("4k3/8/8/8/8/8/8/1N2KN2 w - - 0 1", "b1d2"), "Nbd2");
+    // Rooks on a1 and a5 share a file: rank disambiguation.
+    EXPECT_EQ(format_uci("4k3/8/8/R7/8/8/8/R3K3 w - - 0 1", "a1a3"), "R1a3");
+    // Queens on a1, a3 and c1 all reach b2 and c3; a1 needs file and rank.
+    EXPECT_EQ(format_uci("4k3/8/8/8/8/Q7/8/Q1Q1K3 w - - 0 1", "a1b2"), "Qa1b2");
+}
+
+TEST_F(SanTest, ParsesVariants) {
+    Position pos = Position::initial();
+    EXPECT_EQ(san::parse(pos, "e4").uci(), "e2e4");
+    EXPECT_EQ(san::parse(pos, "Nf3!").uci(), "g1f3");
+    EXPECT_EQ(san::parse(pos, "Ng1f3").uci(), "g1f3");
+
+    Position castle = Position::from_fen("4k3/8/8/8/8/8/8/4K2R w K - 0 1");
+    EXPECT_EQ(san::parse(castle, "0-0").flag, MoveFlag::CastleKingside);
+    EXPECT_EQ(san::parse(castle, "O-O+").flag, MoveFlag::CastleKingside);
+
+    Position promo = Position::from_fen("7k/4P3/8/8/8/8/8/4K3 w - - 0 1");
+    EXPECT_EQ(san::parse(promo, "e8=Q+").uci(), "e7e8q");
+    EXPECT_EQ(san::parse(promo, "e8N").uci(), "e7e8n");
+}
+
+TEST_F(SanTest, RejectsIllegalAndAmbiguous) {
+    Position pos = Position::initial();
+    EXPECT_THROW((void)san::parse(pos, "e5"), std::invalid_argument);
+    EXPECT_THROW((void)san::parse(pos, "O-O"), std::invalid_argument);
+    EXPECT_THROW((void)san::parse(pos, "Zz9"), std::invalid_argument);
+    EXPECT_THROW((void)san::parse(pos, ""), std::invalid_argument);
+
+    Position knights = Position::from_fen("4k3/8/8/8/8/8/8/1N2KN2 w - - 0 1");
+    EXPECT_THROW((void)san::parse(knights, "Nd2"), std::invalid_argument);
+}
+
+TEST_F(SanTest, RoundTripsRandomGames) {
+    std::mt19937 rng(99);
+    for (int game = 0; game < 4; ++game) {
+        Position pos = Position::initial();
+        for (int ply = 0; ply < 120; ++ply) {
+            MoveList moves = movegen::legal(pos);
+            if (moves.empty())
+                break;
+            for (const Move& m : moves) {
+                const std::string text = san::format(pos, m);
+                ASSERT_EQ(san::parse(pos, text), m) << pos.to_fen() << " " << text;
+            }
+            pos.make_move(moves[static_cast<int>(rng() % static_cast<unsigned>(moves.size()))]);
+        }
+    }
+}
@@ -5,12 +5,37 @@
 #include <chessie/magic.hpp>
 #include <chessie/search.hpp>
 
+#include <algorithm>
+#include <atomic>
 #include <chrono>
+#include <exception>
+#include <memory>
+#include <mutex>
+#include <new>
 #include <gtest/gtest.h>
 #include <string_view>
 #include <thread>
+#include <vector>
 
 namespace chessie {
+
+/// Reaches the killers and history of a `Search` between searches.
+struct SearchTestAccess {
+    static void prepare(Search& search, std::string_view fen) {
+        search.prepare_heuristics(Position::from_fen(fen));
+    }
+    static Move& killer(Search& search, int ply, int slot) {
+        return search.stack_[ply].killers[slot];
+    }
+    static int& history(Search& search, Color side, Move m) {
+        return search.history_[color_index(side)][m.from_sq][m.to_sq];
+    }
+    static int quiescence(Search& search, Position& pos, int ply) {
+        search.params_ = eval::params();
+        return search.quiescence(pos, -kInfScore, kInfScore, ply, 0);
+    }
+};
+
 namespace {
 
 // ── Test fixture ────────────────────────────────────────────────────────────
@@ -151,6 +176,59 @@ TEST_F(SearchTest, TimeLimitStopsSearch) {
     EXPECT_LT(ms, 2000);
 }
 
+// Overshoot is the time from the deadline, or from raising the stop flag, to
+// search() returning. Scheduler noise only ever adds to it, so the minimum
+// over a few runs measures the watchdog and the unwinding alone; a watchdog
+// that wakes late or polls the flag slowly raises every run. The bound
+// leaves room for one scheduler time slice on a saturated machine.
+TEST_F(SearchTest, DeadlineOvershootIsSmall) {
+    // A capture-heavy middlegame stresses the quiescence search.
+    constexpr std::string_view kFen =
+        "r3k2r/p1ppqpb1/bn2pnp1/3PN3/1p2P3/2N2Q1p/PPPBBPPP/R3K2R w KQkq - 0 1";
+    constexpr int kLimitMs = 20;
+
+    Search search(1);
+    double best = 1e9;
+    for (int rep = 0; rep < 8; ++rep) {
+        Position pos = Position::from_fen(kFen);
+        SearchLimits limits;
+        limits.time_limit_ms = kLimitMs;
+        const auto deadline = std::chrono::steady_clock::now() +
+                              std::chrono::milliseconds(kLimitMs);
+        (void)search.search(pos, limits);
+        const std::chrono::duration<double, std::milli> overshoot =
+            std::chrono::steady_clock::now() - deadline;
+        best = std::min(best, overshoot.count());
+    }
+    EXPECT_LT(best, 5.0);
+}
+
+TEST_F(SearchTest, StopFlagOvershootIsSmall) {
+    constexpr std::string_view kFen =
+        "r3k2r/p1ppqpb1/bn2pnp1/3PN3/1p2P3/2N2Q1p/PPPBBPPP/R3K2R w KQkq - 0 1";
+
+    Search search(1);
+    double best = 1e9;
+    for (int rep = 0; rep < 8; ++rep) {
+        Position pos = Position::from_fen(kFen);
+        std::atomic<bool> stop{false};
+        SearchLimits limits;
+        limits.stop_flag = &stop;
+        std::chrono::steady_clock::time_point stopped;
+        std::thread stopper([&] {
+            std::this_thread::sleep_for(std::chrono::milliseconds(20));
+            stopped = std::chrono::steady_clock::now();
+            stop.store(true);
+        });
+        (void)search.search(pos, limits);
+        const auto returned = std::chrono::steady_clock::now();
+        stopper.join();
+        const std::chrono::duration<double, std::milli> overshoot = returned - stopped;
+        best = std::min(best, overshoot.count());
+    }
+    EXPECT_LT(best, 5.0);
+}
+
 // ── Tactical positions ──────────────────────────────────────────────────────
 
 TEST_F(SearchTest, CapturesHangingQueen) {
@@ -209,6 +287,168 @@ TEST_F(SearchTest, EngineCancelViaThread) {
     EXPECT_LT(result.depth, 20);
 }
 
+TEST_F(SearchTest, AsyncSearchCompletes) {
+    Engine engine(1);
+    SearchLimits limits;
+    limits.max_depth = 3;
+
+    int callbacks = 0;
+    auto handle = engine.start_search(Position::initial(), limits,
+                                      [&](const SearchResult&) { ++callbacks; });
+    EXPECT_TRUE(handle->wait(std::chrono::seconds(30)));
+    EXPECT_TRUE(handle->poll());
+    EXPECT_EQ(handle->error(), nullptr);
+    EXPECT_EQ(handle->result().depth, 3);
+    // last_result() waits for the search thread, so the callback has run.
+    EXPECT_EQ(engine.last_result().best_move, handle->result().best_move);
+    EXPECT_EQ(callbacks, 1);
+}
+
+TEST_F(SearchTest, AsyncCallbackSeesFinishedHandleAndMayRestart) {
+    Engine engine(1);
+    SearchLimits limits;
+    limits.max_depth = 2;
+
+    std::shared_ptr<SearchHandle> first;
+    std::shared_ptr<SearchHandle> second;
+    bool finished_in_callback = false;
+    std::mutex mutex;
+    std::unique_lock lock(mutex);
+    first = engine.start_search(Position::initial(), limits, [&](const SearchResult& result) {
+        std::lock_guard guard(mutex);
+        // The handle already reports completion; waiting on it returns.
+        first->wait();
+        finished_in_callback = first->poll() && first->result().depth == result.depth;
+        // Starting again from the search thread must not join itself.
+        second = engine.start_search(Position::initial(), limits);
+    });
+    lock.unlock();
+
+    EXPECT_TRUE(first->wait(std::chrono::seconds(30)));
+    // Wait until the callback has started the second search.
+    for (;;) {
+        std::lock_guard guard(mutex);
+        if (second)
+            break;
+    }
+    EXPECT_TRUE(second->wait(std::chrono::seconds(30)));
+    EXPECT_TRUE(finished_in_callback);
+    EXPECT_EQ(engine.last_result().depth, 2);
+}
+
+TEST_F(SearchTest, AsyncSearchesShareOneThread) {
+    Engine engine(1);
+    SearchLimits limits;
+    limits.max_depth = 2;
+
+    std::thread::id ids[3];
+    for (std::thread::id& id : ids) {
+        auto handle = engine.start_search(Position::initial(), limits, [&id](const SearchResult&) {
+            id = std::this_thread::get_id();
+        });
+        handle->wait();
+        (void)engine.last_result();
+    }
+    EXPECT_NE(ids[0], std::this_thread::get_id());
+    EXPECT_EQ(ids[1], ids[0]);
+    EXPECT_EQ(ids[2], ids[0]);
+}
+
+TEST_F(SearchTest, ConcurrentStartsSupersedeEachOther) {
+    Engine engine(1);
+    SearchLimits limits;
+    limits.max_depth = 64;
+
+    constexpr int kThreads = 4;
+    std::shared_ptr<SearchHandle> handles[kThreads][5];
+    std::vector<std::thread> threads;
+    for (auto& row : handles) {
+        threads.emplace_back([&engine, &limits, &row] {
+            for (auto& handle : row) handle = engine.start_search(Position::initial(), limits);
+        });
+    }
+    for (std::thread& t : threads) t.join();
+    (void)engine.last_result();
+    for (const auto& row : handles) {
+        for (const auto& handle : row) EXPECT_TRUE(handle->poll());
+    }
+}
+
+TEST_F(SearchTest, CallbackMayDestroyEngine) {
+    auto engine = std::make_unique<Engine>(1);
+    SearchLimits limits;
+    limits.max_depth = 2;
+
+    std::atomic<bool> destroyed{false};
+    auto handle = engine->start_search(Position::initial(), limits, [&](const SearchResult&) {
+        engine.reset();
+        destroyed.store(true);
+    });
+    handle->wait();
+    while (!destroyed.load()) std::this_thread::yield();
+    EXPECT_EQ(handle->result().depth, 2);
+}
+
+TEST_F(SearchTest, AsyncSearchReportsErrors) {
+    // A table far beyond the address space cannot be allocated.
+    Engine engine(std::size_t{1} << 38);
+    SearchLimits limits;
+    limits.max_depth = 2;
+    bool called = false;
+    auto handle = engine.start_search(Position::initial(), limits,
+                                      [&](const SearchResult&) { called = true; });
+    EXPECT_TRUE(handle->wait(std::chrono::seconds(30)));
+    ASSERT_NE(handle->error(), nullptr);
+    EXPECT_THROW(std::rethrow_exception(handle->error()), std::bad_alloc);
+    (void)engine.last_result();
+    EXPECT_TRUE(called);
+}
+
+TEST_F(SearchTest, SynchronousSearchStopsAsyncOne) {
+    Engine engine(1);
+    SearchLimits limits;
+    limits.max_depth = 64;
+    auto running = engine.start_search(Position::initial(), limits);
+
+    Position pos = Position::initial();
+    limits.max_depth = 2;
+    const SearchResult result = engine.search(pos, limits);
+    EXPECT_TRUE(running->poll());
+    EXPECT_EQ(result.depth, 2);
+}
+
+TEST_F(SearchTest, AsyncSearchStopsOnRequest) {
+    Engine engine(1);
+    SearchLimits limits;
+    limits.max_depth = 64;
+
+    auto handle = engine.start_search(Position::initial(), limits);
+    EXPECT_FALSE(handle->wait(std::chrono::milliseconds(20)));
+    handle->stop();
+    handle->wait();
+    EXPECT_TRUE(handle->poll());
+    EXPECT_FALSE(handle->result().best_move.is_null());
+    EXPECT_LT(handle->result().depth, 20);
+
+    // A stop requested before the thread starts searching is not lost.
+    auto early = engine.start_search(Position::initial(), limits);
+    early->stop();
+    EXPECT_TRUE(early->wait(std::chrono::seconds(30)));
+}
+
+TEST_F(SearchTest, NewAsyncSearchSupersedesRunningOne) {
+    Engine engine(1);
+    SearchLimits limits;
+    limits.max_depth = 64;
+    auto first = engine.start_search(Position::initial(), limits);
+
+    limits.max_depth = 2;
+    auto second = engine.start_search(Position::initial(), limits);
+    EXPECT_TRUE(first->poll());
+    second->wait();
+    EXPECT_EQ(second->result().depth, 2);
+}
+
 TEST_F(SearchTest, EngineSetTTSize) {
     Engine engine(1);
     engine.set_tt_size(2);
@@ -236,6 +476,262 @@ TEST_F(SearchTest, DepthFiveFromStart) {
     EXPECT_EQ(result.depth, 5);
 }
 
+TEST_F(SearchTest, CountsLazyEvalTiers) {
+    if (!kSearchStats)
+        GTEST_SKIP() << "built without SEARCH_STATS";
+    // A material imbalance makes many stand-pat evaluations lazy.
+    Position pos =
+        Position::from_fen("rnb1kbnr/pppp1ppp/8/4p3/4P3/5N2/PPPP1PPP/RNBQKB1R w KQkq - 0 3");
+    Search search(1);
+    SearchLimits limits;
+    limits.max_depth = 4;
+    search.search(pos, limits);
+    const eval::EvalStats& stats = search.eval_stats();
+    EXPECT_GT(stats.lazy, 0U);
+    EXPECT_GT(stats.full, 0U);
+}
+
+TEST_F(SearchTest, AgedHeuristicsKeepResultsLegal) {
+    // Consecutive positions of one game, searched with aged heuristics.
+    Search search(1);
+    search.set_heuristic_reuse(HeuristicReuse::Age);
+    SearchLimits limits;
+    limits.max_depth = 4;
+
+    Position pos = Position::from_fen(kStartingFen);
+    for (int ply = 0; ply < 6; ++ply) {
+        Position root = pos;
+        SearchResult result = search.search(root, limits);
+        ASSERT_FALSE(result.best_move.is_null());
+        EXPECT_TRUE(is_legal(pos.to_fen(), result.best_move));
+        pos.make_move(result.best_move);
+    }
+}
+
+TEST_F(SearchTest, AgedHeuristicsMatchClearOnFirstSearch) {
+    SearchLimits limits;
+    limits.max_depth = 5;
+    Search cleared(1);
+    Search aged(1);
+    aged.set_heuristic_reuse(HeuristicReuse::Age);
+
+    // Nothing to carry over yet, so both modes search identical trees.
+    Position a = Position::from_fen(kStartingFen);
+    Position b = Position::from_fen(kStartingFen);
+    EXPECT_EQ(cleared.search(a, limits).nodes, aged.search(b, limits).nodes);
+}
+
+TEST_F(SearchTest, AgingShiftsKillersAndHalvesHistory) {
+    using Access = SearchTestAccess;
+    // Only the side to move and the move number matter to the aging.
+    constexpr std::string_view kPly0 = "4k3/8/8/8/8/8/8/4K3 w - - 0 1";
+    constexpr std::string_view kPly2 = "4k3/8/8/8/8/8/8/4K3 w - - 0 2";
+    constexpr std::string_view kPly3 = "4k3/8/8/8/8/8/8/4K3 b - - 0 2";
+    const Move e2e4 = Move::from_uci("e2e4");
+    // A distinct killer pair per ply: the plies map onto board squares.
+    const auto killer_at = [](int ply, int slot) {
+        return Move{static_cast<Square>(ply % 64), static_cast<Square>(32 + slot)};
+    };
+    const auto fill = [&](Search& search) {
+        for (int ply = 0; ply < kMaxPly; ++ply) {
+            Access::killer(search, ply, 0) = killer_at(ply, 0);
+            Access::killer(search, ply, 1) = killer_at(ply, 1);
+        }
+        Access::history(search, Color::White, e2e4) = 1000;
+    };
+
+    Search search(1);
+    search.set_heuristic_reuse(HeuristicReuse::Age);
+    Access::prepare(search, kPly0);
+    fill(search);
+
+    // Two plies later, ply p of the new search was ply p + 2 of the old one.
+    Access::prepare(search, kPly2);
+    for (int ply = 0; ply < kMaxPly - 2; ++ply) {
+        EXPECT_EQ(Access::killer(search, ply, 0), killer_at(ply + 2, 0));
+        EXPECT_EQ(Access::killer(search, ply, 1), killer_at(ply + 2, 1));
+    }
+    EXPECT_TRUE(Access::killer(search, kMaxPly - 2, 0).is_null());
+    EXPECT_TRUE(Access::killer(search, kMaxPly - 1, 1).is_null());
+    EXPECT_EQ(Access::history(search, Color::White, e2e4), 500);
+
+    // Another ply shifts by one more and halves again.
+    fill(search);
+    Access::prepare(search, kPly3);
+    EXPECT_EQ(Access::killer(search, 0, 0), killer_at(1, 0));
+    EXPECT_EQ(Access::history(search, Color::White, e2e4), 500);
+
+    // A root before the previous one (a new game, a take-back) clears.
+    fill(search);
+    Access::prepare(search, kPly0);
+    EXPECT_TRUE(Access::killer(search, 0, 0).is_null());
+    EXPECT_TRUE(Access::killer(search, 5, 1).is_null());
+    EXPECT_EQ(Access::history(search, Color::White, e2e4), 0);
+
+    // The Clear mode never carries anything over.
+    search.set_heuristic_reuse(HeuristicReuse::Clear);
+    fill(search);
+    Access::prepare(search, kPly2);
+    EXPECT_TRUE(Access::killer(search, 0, 0).is_null());
+    EXPECT_EQ(Access::history(search, Color::White, e2e4), 0);
+}
+
+TEST_F(SearchTest, UnplayableKillersAreSkipped) {
+    using Access = SearchTestAccess;
+    constexpr std::string_view kFen =
+        "r3k2r/p1ppqpb1/bn2pnp1/3PN3/1p2P3/2N2Q1p/PPPBBPPP/R3K2R w KQkq - 0 1";
+    SearchLimits limits;
+    limits.max_depth = 5;
+
+    // A move onto its own origin square is never pseudo-legal, so killers
+    // like these must be dropped by the validation and leave the tree as
+    // a search without killers would have it.
+    Search stale(1);
+    stale.set_heuristic_reuse(HeuristicReuse::Age);
+    Access::prepare(stale, kFen);
+    for (int ply = 0; ply < kMaxPly; ++ply) {
+        Access::killer(stale, ply, 0) = Move{E1, E1};
+        Access::killer(stale, ply, 1) = Move{D5, D5};
+    }
+    Search clean(1);
+
+    Position a = Position::from_fen(kFen);
+    Position b = Position::from_fen(kFen);
+    const SearchResult with_stale = stale.search(a, limits);
+    const SearchResult without = clean.search(b, limits);
+    EXPECT_EQ(with_stale.nodes, without.nodes);
+    EXPECT_EQ(with_stale.best_move, without.best_move);
+}
+
+TEST_F(SearchTest, TTScoresKeepMateDistance) {
+    for (int ply : {0, 5, 60}) {
+        for (int score : {0, 350, -350, kMateScore - ply - 3, -kMateScore + ply + 3}) {
+            const int stored = score_to_tt(score, ply);
+            EXPECT_LE(std::abs(stored), kTTMateScore);
+            EXPECT_EQ(score_from_tt(stored, ply), score) << score << " at ply " << ply;
+        }
+    }
+    // A mate 3 plies from the storing node, read back 4 plies deeper.
+    EXPECT_EQ(score_from_tt(score_to_tt(kMateScore - 5, 2), 6), kMateScore - 9);
+    // Ordinary scores stay out of the mate range.
+    EXPECT_EQ(score_to_tt(kTTMateScore, 0), kTTMateScore - kMaxPly);
+}
+
+TEST_F(SearchTest, QuiescenceStoresMateScores) {
+    // Black's only evasion, Rd8, loses to Rxd8#.
+    Position pos = Position::from_fen("R5k1/5ppp/3r4/8/8/8/8/6K1 b - - 0 1");
+    Search search(1);
+    EXPECT_EQ(SearchTestAccess::quiescence(search, pos, 0), -kMateScore + 2);
+
+    TTEntry entry;
+    ASSERT_TRUE(search.tt().probe(pos.key(), entry));
+    EXPECT_EQ(entry.bound, Bound::Exact);
+    EXPECT_EQ(score_from_tt(entry.score, 0), -kMateScore + 2);
+    // Reached again 4 plies deeper, it is still mated 2 plies later.
+    EXPECT_EQ(score_from_tt(entry.score, 4), -kMateScore + 6);
+}
+
+TEST_F(SearchTest, ReportsSeldepthTimeAndHashfull) {
+    Position pos = Position::from_fen(kStartingFen);
+    Search search(1);
+    SearchLimits limits;
+    limits.max_depth = 5;
+    SearchResult result = search.search(pos, limits);
+
+    // Quiescence extends past the nominal depth.
+    EXPECT_GT(result.seldepth, result.depth);
+    EXPECT_GT(result.hashfull, 0);
+    EXPECT_LE(result.hashfull, 1000);
+    EXPECT_GT(result.nps, 0U);
+    EXPECT_GE(result.time_ms, 0);
+
+    int prev_seldepth = 0;
+    std::int64_t prev_time = 0;
+    for (const IterationStats& it : result.stats.iterations) {
+        EXPECT_GE(it.seldepth, it.depth);
+        EXPECT_GE(it.seldepth, prev_seldepth);
+        EXPECT_GE(it.time_ms, prev_time);
+        prev_seldepth = it.seldepth;
+        prev_time = it.time_ms;
+    }
+    EXPECT_EQ(result.stats.iterations.back().seldepth, result.seldepth);
+}
+
+TEST_F(SearchTest, RespectsNodeLimit) {
+    Position pos = Position::from_fen(kStartingFen);
+    Search search(1);
+    SearchLimits limits;
+    limits.max_nodes = 5000;
+    SearchResult result = search.search(pos, limits);
+    EXPECT_FALSE(result.best_move.is_null());
+    EXPECT_GE(result.depth, 1);
+    EXPECT_LE(result.nodes, limits.max_nodes);
+}
+
+TEST_F(SearchTest, ReportsRootMoves) {
+    Position pos = Position::from_fen(kStartingFen);
+    Search search(1);
+    SearchLimits limits;
+    limits.max_depth = 5;
+    SearchResult result = search.search(pos, limits);
+
+    ASSERT_EQ(result.root_moves.size(), 20U);
+    const RootMove& best = result.root_moves.front();
+    EXPECT_EQ(best.move, result.best_move);
+    EXPECT_EQ(best.score, result.score_cp);
+
+    // The PV is a legal line starting with the best move.
+    ASSERT_FALSE(best.pv.empty());
+    EXPECT_EQ(best.pv.front(), best.move);
+    for (const Move& m : best.pv) {
+        ASSERT_TRUE(is_legal(pos.to_fen(), m));
+        pos.make_move(m);
+    }
+
+    // Every node below the root belongs to exactly one root move.
+    std::uint64_t subtree_nodes = 0;
+    for (const RootMove& rm : result.root_moves) subtree_nodes += rm.nodes;
+    EXPECT_EQ(subtree_nodes, result.nodes);
+    EXPECT_GT(result.best_move_node_fraction(), 0.0);
+    EXPECT_LE(result.best_move_node_fraction(), 1.0);
+    EXPECT_DOUBLE_EQ(result.stats.iterations.back().best_move_node_fraction,
+                     result.best_move_node_fraction());
+}
+
+TEST_F(SearchTest, CollectsSearchStats) {
+    Position pos = Position::from_fen(kStartingFen);
+    Search search(1);
+    SearchLimits limits;
+    limits.max_depth = 5;
+    SearchResult result = search.search(pos, limits);
+    const SearchStats& stats = result.stats;
+
+    // Iterations are recorded regardless of the build switch.
+    ASSERT_EQ(stats.iterations.size(), 5U);
+    std::uint64_t iteration_nodes = 0;
+    for (std::size_t i = 0; i < stats.iterations.size(); ++i) {
+        EXPECT_EQ(stats.iterations[i].depth, static_cast<int>(i) + 1);
+        iteration_nodes += stats.iterations[i].nodes;
+    }
+    EXPECT_EQ(iteration_nodes, result.nodes);
+    EXPECT_EQ(stats.iterations[0].ebf, 0.0);
+    EXPECT_GT(stats.iterations[4].ebf, 1.0);
+
+    if (!kSearchStats)
+        GTEST_SKIP() << "built without SEARCH_STATS";
+    EXPECT_GT(stats.qnodes, 0U);
+    EXPECT_LT(stats.qnodes, result.nodes);
+    EXPECT_GE(stats.tt_probes, stats.tt_hits);
+    EXPECT_GE(stats.tt_hits, stats.tt_cutoffs);
+    EXPECT_GT(stats.tt_hits, 0U);
+    EXPECT_GE(stats.null_tries, stats.null_cutoffs);
+    EXPECT_GT(stats.beta_cutoffs, 0U);
+    EXPECT_GE(stats.beta_cutoffs, stats.first_move_cutoffs);
+    EXPECT_GT(stats.first_move_cutoff_rate(), 0.5);
+    EXPECT_LE(stats.first_move_cutoff_rate(), 1.0);
+    EXPECT_EQ(&search.stats().eval, &search.eval_stats());
+}
+
 // ── Promotion awareness ─────────────────────────────────────────────────────
 
 TEST_F(SearchTest, FindsPromotionWin) {
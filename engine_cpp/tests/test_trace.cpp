@@ -0,0 +1,116 @@
+/// @file test_trace.cpp
+/// Tests for span recording and Chrome trace export.
+
+#include <chessie/magic.hpp>
+#include <chessie/search.hpp>
+#include <chessie/trace.hpp>
+
+#include <gtest/gtest.h>
+#include <string>
+#include <thread>
+
+using namespace chessie;
+
+class TraceTest : public ::testing::Test {
+   protected:
+    void SetUp() override { trace::clear(); }
+    void TearDown() override { trace::clear(); }
+};
+
+TEST_F(TraceTest, RecordsScopedSpans) {
+    {
+        trace::Span outer("outer", 42);
+        trace::Span inner("inner");
+        inner.set_detail("e2e4");
+    }
+    EXPECT_EQ(trace::size(), 2U);
+
+    std::string json = trace::dump_json();
+    EXPECT_EQ(json.rfind("{\"displayTimeUnit\":\"ms\",\"traceEvents\":[", 0), 0U);
+    EXPECT_NE(json.find("\"name\":\"outer\""), std::string::npos);
+    EXPECT_NE(json.find("\"args\":{\"value\":42}"), std::string::npos);
+    EXPECT_NE(json.find("\"args\":{\"detail\":\"e2e4\"}"), std::string::npos);
+    EXPECT_NE(json.find("\"ph\":\"X\""), std::string::npos);
+
+    trace::clear();
+    EXPECT_EQ(trace::size(), 0U);
+    EXPECT_EQ(trace::dump_json(), "{\"displayTimeUnit\":\"ms\",\"traceEvents\":[]}\n");
+}
+
+TEST_F(TraceTest, SpanDurationIsOrdered) {
+    trace::Event event;
+    event.name = "manual";
+    event.begin_ns = trace::now_ns();
+    event.end_ns = trace::now_ns();
+    EXPECT_LE(event.begin_ns, event.end_ns);
+    trace::record(event);
+    EXPECT_EQ(trace::size(), 1U);
+}
+
+TEST_F(TraceTest, EscapesAndTruncatesDetail) {
+    {
+        trace::Span span("quoted");
+        span.set_detail("a\"b\\cdefghij");
+    }
+    std::string json = trace::dump_json();
+    EXPECT_NE(json.find("\"detail\":\"a\\\"b\\\\cde\""), std::string::npos) << json;
+}
+
+TEST_F(TraceTest, RingBufferKeepsNewestSpans) {
+    trace::Event event;
+    event.name = "tick";
+    for (std::size_t i = 0; i < trace::kRingCapacity + 10; ++i) {
+        event.arg = static_cast<std::int64_t>(i);
+        trace::record(event);
+    }
+    EXPECT_EQ(trace::size(), trace::kRingCapacity);
+
+    std::string json = trace::dump_json();
+    EXPECT_EQ(json.find("\"value\":9}"), std::string::npos);
+    EXPECT_NE(json.find("\"value\":10}"), std::string::npos);
+}
+
+TEST_F(TraceTest, ThreadsRecordIntoSeparateBuffers) {
+    std::thread worker([] { trace::Span span("worker"); });
+    worker.join();
+    { trace::Span span("main"); }
+    EXPECT_EQ(trace::size(), 2U);
+}
+
+TEST_F(TraceTest, ExitedThreadsHandTheirBufferOn) {
+    // The tid of the one exported span, i.e. the buffer it was recorded in.
+    const auto record_on_new_thread = [] {
+        trace::clear();
+        std::thread worker([] { trace::Span span("worker"); });
+        worker.join();
+        const std::string json = trace::dump_json();
+        const std::size_t at = json.find("\"tid\":");
+        return json.substr(at, json.find_first_of(",}", at) - at);
+    };
+    const std::string first = record_on_new_thread();
+    EXPECT_EQ(record_on_new_thread(), first);
+
+    // The spans of an exited thread survive until the new owner overwrites them.
+    trace::clear();
+    std::thread([] { trace::Span span("first"); }).join();
+    std::thread([] { trace::Span span("second"); }).join();
+    EXPECT_EQ(trace::size(), 2U);
+}
+
+TEST_F(TraceTest, SearchEmitsSpansWhenEnabled) {
+    magic::init();
+    Position pos = Position::initial();
+    Search search(1);
+    SearchLimits limits;
+    limits.max_depth = 2;
+    search.search(pos, limits);
+
+    std::string json = trace::dump_json();
+    if (trace::kEnabled) {
+        EXPECT_NE(json.find("\"name\":\"iteration\""), std::string::npos);
+        EXPECT_NE(json.find("\"name\":\"root_move\""), std::string::npos);
+        EXPECT_NE(json.find("\"name\":\"search\""), std::string::npos);
+    } else {
+        EXPECT_EQ(trace::size(), 0U);
+    }
+}
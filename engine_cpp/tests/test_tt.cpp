@@ -3,8 +3,11 @@
 
 #include <chessie/tt.hpp>
 
+#include <atomic>
 #include <cstdint>
 #include <gtest/gtest.h>
+#include <thread>
+#include <vector>
 
 namespace chessie {
 namespace {
@@ -165,6 +168,24 @@ TEST(TTTest, StaleEntryReplacedByNewAge) {
     EXPECT_EQ(entry.age, 1);
 }
 
+TEST(TTTest, QuiescenceDepthRoundTrips) {
+    TranspositionTable tt(1);
+    const std::uint64_t key = 0x1234123412341234;
+
+    tt.store(key, -1, 42, Bound::Lower, kNullMove, 42);
+    TTEntry entry{};
+    ASSERT_TRUE(tt.probe(key, entry));
+    EXPECT_EQ(entry.depth, -1);
+
+    // Any main-search result outranks a quiescence one.
+    tt.store(key, 1, 17, Bound::Upper, kNullMove, 17);
+    ASSERT_TRUE(tt.probe(key, entry));
+    EXPECT_EQ(entry.depth, 1);
+    tt.store(key, -1, 42, Bound::Upper, kNullMove, 42);
+    ASSERT_TRUE(tt.probe(key, entry));
+    EXPECT_EQ(entry.depth, 1);
+}
+
 TEST(TTTest, ProbeStillFindsOldAgeEntry) {
     TranspositionTable tt(1);
     const std::uint64_t key = 0xCCCCDDDDEEEEFFFF;
@@ -226,6 +247,22 @@ TEST(TTTest, HashfullAfterStores) {
     EXPECT_LE(fill, 1000);
 }
 
+TEST(TTTest, HashfullSamplesWholeTable) {
+    TranspositionTable tt(1);
+    Move m{E2, E4, MoveFlag::DoublePawn, PieceType::None};
+
+    // Fill only the upper half of the table; a prefix sample would read 0.
+    const std::size_t n = tt.entry_count();
+    for (std::size_t i = n / 2; i < n; ++i) {
+        tt.store(i, 3, 50, Bound::Lower, m, 25);
+    }
+    EXPECT_EQ(tt.hashfull(), 500);
+
+    // Entries from a previous search no longer count.
+    tt.new_search();
+    EXPECT_EQ(tt.hashfull(), 0);
+}
+
 // ── Move preservation ───────────────────────────────────────────────────────
 
 TEST(TTTest, PreserveBestMoveOnSameKeyNullMove) {
@@ -297,5 +334,122 @@ TEST(TTTest, MateScoreRoundTrip) {
     EXPECT_EQ(entry.score, 29998);
 }
 
+// ── Lazy allocation & rehash ────────────────────────────────────────────────
+
+TEST(TTTest, AllocatesLazily) {
+    TranspositionTable tt(4);
+    EXPECT_FALSE(tt.allocated());
+    TTEntry entry{};
+    EXPECT_FALSE(tt.probe(0x1234, entry));
+    EXPECT_EQ(tt.hashfull(), 0);
+
+    tt.new_search();
+    EXPECT_TRUE(tt.allocated());
+    tt.store(0x1234, 3, 10, Bound::Exact, Move{}, 0);
+    EXPECT_TRUE(tt.probe(0x1234, entry));
+
+    // Clearing keeps the storage, which other threads may still be using.
+    tt.clear();
+    EXPECT_TRUE(tt.allocated());
+    EXPECT_FALSE(tt.probe(0x1234, entry));
+}
+
+namespace {
+
+/// Keys spread over every index and hint bit.
+std::uint64_t rehash_key(std::uint64_t i) {
+    return (i * 0x9E3779B97F4A7C15ULL) ^ (i << 40);
+}
+
+/// Store `count` entries whose keys differ in their low 17 bits.
+void fill(TranspositionTable& tt, std::uint64_t count) {
+    for (std::uint64_t i = 0; i < count; ++i) {
+        const Move m{E2, E4, MoveFlag::DoublePawn, PieceType::None};
+        tt.store((rehash_key(i) & ~0x1FFFFULL) | i, 4, static_cast<int>(i % 1000), Bound::Lower,
+                 m, 7);
+    }
+}
+
+int survivors(const TranspositionTable& tt, std::uint64_t count) {
+    int found = 0;
+    TTEntry entry{};
+    for (std::uint64_t i = 0; i < count; ++i) {
+        if (tt.probe((rehash_key(i) & ~0x1FFFFULL) | i, entry) &&
+            entry.score == static_cast<int>(i % 1000) && entry.bound == Bound::Lower &&
+            entry.best_move.to_sq == E4) {
+            ++found;
+        }
+    }
+    return found;
+}
+
+}  // namespace
+
+TEST(TTTest, RehashKeepsEntriesWhenGrowing) {
+    TranspositionTable tt(1);  // 2^16 entries
+    fill(tt, 20000);
+    tt.rehash(8);
+    EXPECT_EQ(tt.entry_count(), 1U << 19);
+    EXPECT_EQ(survivors(tt, 20000), 20000);
+}
+
+TEST(TTTest, RehashKeepsEntriesWhenShrinking) {
+    TranspositionTable tt(4);
+    fill(tt, 20000);
+    tt.rehash(1);
+    EXPECT_EQ(tt.entry_count(), 1U << 16);
+    EXPECT_EQ(survivors(tt, 20000), 20000);
+
+    // A full table halved: pairs collide and one entry of each survives.
+    TranspositionTable full(2);
+    fill(full, 1U << 17);
+    full.rehash(1);
+    EXPECT_EQ(survivors(full, 1U << 17), 1 << 16);
+
+    full.resize(1);
+    EXPECT_EQ(survivors(full, 1U << 17), 0);
+}
+
+TEST(TTTest, RehashOfUnallocatedTableStaysLazy) {
+    TranspositionTable tt(1);
+    tt.rehash(2);
+    EXPECT_FALSE(tt.allocated());
+    EXPECT_EQ(tt.entry_count(), 1U << 17);
+}
+
+// ── Concurrent access ───────────────────────────────────────────────────────
+
+TEST(TTTest, ConcurrentWritersNeverYieldTornEntries) {
+    TranspositionTable tt(1);
+    const std::uint64_t low = 0x42;  // every key maps to the same slot
+
+    // Each writer stores entries whose fields are all derived from the key,
+    // so any hit that mixes two writes shows up as a mismatch.
+    auto score_of = [](std::uint32_t hi) { return static_cast<int>(hi % 20000) - 10000; };
+    std::atomic<int> mismatches{0};
+    std::vector<std::thread> threads;
+    for (std::uint32_t t = 0; t < 4; ++t) {
+        threads.emplace_back([&, t] {
+            TTEntry entry{};
+            for (std::uint32_t i = 0; i < 200000; ++i) {
+                const std::uint32_t hi = t * 1000003U + i;
+                const std::uint64_t key = std::uint64_t{hi} << 32 | low;
+                const auto sq = static_cast<Square>(hi % 64);
+                tt.store(key, static_cast<int>(hi % 60), score_of(hi), Bound::Exact,
+                         Move{sq, sq, MoveFlag::Normal, PieceType::None}, score_of(hi));
+                if (tt.probe(key ^ (std::uint64_t{1} << 32), entry) &&
+                    (entry.score != score_of(entry.key32) ||
+                     entry.static_eval != score_of(entry.key32) ||
+                     entry.best_move.from_sq != entry.key32 % 64 ||
+                     entry.depth != static_cast<int>(entry.key32 % 60))) {
+                    mismatches.fetch_add(1);
+                }
+            }
+        });
+    }
+    for (auto& th : threads) th.join();
+    EXPECT_EQ(mismatches.load(), 0);
+}
+
 }  // namespace
 }  // namespace chessie
@@ -0,0 +1,102 @@
+/// @file test_tuner.cpp
+/// Tests for the Texel tuner: dataset packing, conversion and descent.
+
+#include <chessie/magic.hpp>
+#include <chessie/tuner.hpp>
+
+#include <cstdio>
+#include <cstring>
+#include <fstream>
+#include <gtest/gtest.h>
+#include <sstream>
+#include <string>
+#include <vector>
+
+using namespace chessie;
+
+class TunerTest : public ::testing::Test {
+   public:
+    static void SetUpTestSuite() { magic::init(); }
+};
+
+// ── Packing ─────────────────────────────────────────────────────────────────
+
+TEST_F(TunerTest, PackUnpackRoundTrip) {
+    auto pos = Position::from_fen("r1bqkbnr/pppp1ppp/2n5/4p3/4P3/5N2/PPPP1PPP/RNBQKB1R b - - 0 1");
+    tune::PackedPosition packed = tune::pack(pos, 0.5);
+    Position back = tune::unpack(packed);
+    EXPECT_EQ(back.to_fen(), pos.to_fen());
+    EXPECT_DOUBLE_EQ(tune::white_result(packed), 0.5);
+}
+
+TEST_F(TunerTest, ConvertTextParsesResultFormats) {
+    std::istringstream in(
+        "4k3/8/8/8/3Q4/8/8/4K3 w - - 0 1 [1.0]\n"
+        "4k3/8/8/3q4/8/8/8/4K3 b - - c9 \"0-1\";\n"
+        "8/8/8/3k4/8/8/4P3/4K3 w - - 1/2-1/2\n"
+        "garbage line\n"
+        "4k3/8/8/8/8/8/8/4K3 w - - 0 1 [2.0]\n");
+    std::ostringstream out;
+    EXPECT_EQ(tune::convert_text(in, out), 3U);
+
+    const std::string bytes = out.str();
+    ASSERT_EQ(bytes.size(), 3 * sizeof(tune::PackedPosition));
+    std::vector<tune::PackedPosition> records(3);
+    std::memcpy(records.data(), bytes.data(), bytes.size());
+    EXPECT_DOUBLE_EQ(tune::white_result(records[0]), 1.0);
+    EXPECT_DOUBLE_EQ(tune::white_result(records[1]), 0.0);
+    EXPECT_DOUBLE_EQ(tune::white_result(records[2]), 0.5);
+    EXPECT_EQ(tune::unpack(records[1]).side_to_move(), Color::Black);
+}
+
+// ── Dataset ─────────────────────────────────────────────────────────────────
+
+TEST_F(TunerTest, DatasetMappedAndReadAgree) {
+    const std::string path = ::testing::TempDir() + "chessie_tuner_dataset.bin";
+    {
+        std::ofstream out(path, std::ios::binary);
+        for (const char* fen :
+             {"4k3/8/8/8/3Q4/8/8/4K3 w - - 0 1", "8/8/8/3k4/8/8/4P3/4K3 w - - 0 1"}) {
+            auto packed = tune::pack(Position::from_fen(fen), 1.0);
+            out.write(reinterpret_cast<const char*>(&packed), sizeof(packed));
+        }
+    }
+    tune::Dataset mapped(path, true);
+    tune::Dataset read(path, false);
+    ASSERT_EQ(mapped.size(), 2U);
+    ASSERT_EQ(read.size(), 2U);
+    EXPECT_FALSE(read.mapped());
+    EXPECT_EQ(std::memcmp(mapped.positions().data(), read.positions().data(),
+                          2 * sizeof(tune::PackedPosition)),
+              0);
+    std::remove(path.c_str());
+}
+
+// ── Descent ─────────────────────────────────────────────────────────────────
+
+TEST_F(TunerTest, StepsReduceError) {
+    // White wins every game with an extra knight: the tuner should learn that
+    // the knight is worth more once its value starts far too low.
+    std::vector<tune::PackedPosition> data;
+    const char* fens[] = {
+        "4k3/8/8/8/3N4/8/8/4K3 w - - 0 1",
+        "4k3/8/8/8/8/2N5/8/4K3 b - - 0 1",
+        "3k4/8/8/5N2/8/8/8/3K4 w - - 0 1",
+        "4k3/8/8/8/8/8/8/4K3 w - - 0 1",
+    };
+    for (int i = 0; i < 4; ++i) {
+        data.push_back(tune::pack(Position::from_fen(fens[i]), i == 3 ? 0.5 : 1.0));
+    }
+
+    eval::Params initial = eval::default_params();
+    initial.piece_value(1) = {0, 0};
+    tune::Tuner tuner(data, initial, 2);
+    ASSERT_EQ(tuner.size(), 4U);
+
+    double before = tuner.error(1.0);
+    for (int i = 0; i < 50; ++i) {
+        tuner.step(1.0, 5.0);
+    }
+    EXPECT_LT(tuner.error(1.0), before);
+    EXPECT_GT(tuner.params().piece_value(1).mg, 0);
+}
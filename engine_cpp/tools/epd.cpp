@@ -0,0 +1,131 @@
+/// @file epd.cpp
+/// `chessie_epd`: run an EPD test suite and report solved positions.
+///
+/// Usage:
+///   chessie_epd FILE [--depth N] [--nodes N] [--movetime MS] [--threads N]
+///               [--hash MB] [--min-solved N]
+///
+/// Exits with status 1 when fewer than `--min-solved` positions are solved,
+/// so a suite run can serve as an acceptance gate.
+
+#include <chessie/epd.hpp>
+#include <chessie/magic.hpp>
+
+#include <cstdio>
+#include <exception>
+#include <fstream>
+#include <stdexcept>
+#include <string>
+#include <string_view>
+#include <vector>
+
+namespace {
+
+using namespace chessie;
+
+void print_usage() {
+    std::fprintf(stderr,
+                 "usage:\n"
+                 "  chessie_epd FILE [--depth N] [--nodes N] [--movetime MS] [--threads N]\n"
+                 "              [--hash MB] [--min-solved N]\n");
+}
+
+void print_result(const epd::Record& record, const epd::PositionResult& r) {
+    const std::string name = record.id.empty() ? "#" + std::to_string(r.index + 1) : record.id;
+    std::printf("%-16s %-6s %-5s depth %2d  nodes %10llu  time %6lld ms", name.c_str(),
+                r.solved ? "solved" : "failed", r.move.uci().c_str(), r.depth,
+                static_cast<unsigned long long>(r.nodes), static_cast<long long>(r.time_ms));
+    if (r.solved) {
+        std::printf("  (found at depth %d, %lld ms, %llu nodes)", r.solution_depth,
+                    static_cast<long long>(r.time_to_solution_ms),
+                    static_cast<unsigned long long>(r.nodes_to_solution));
+    }
+    std::printf("\n");
+    std::fflush(stdout);
+}
+
+int run(const std::vector<std::string_view>& args) {
+    if (args.empty()) {
+        print_usage();
+        return 2;
+    }
+
+    epd::RunConfig config;
+    int min_solved = 0;
+    bool limited = false;
+
+    for (std::size_t i = 1; i < args.size(); ++i) {
+        std::string_view a = args[i];
+        auto value = [&]() -> std::string {
+            if (i + 1 >= args.size()) {
+                throw std::invalid_argument("missing value for " + std::string(a));
+            }
+            return std::string(args[++i]);
+        };
+        if (a == "--depth") {
+            config.limits.max_depth = std::stoi(value());
+            limited = true;
+        } else if (a == "--nodes") {
+            config.limits.max_nodes = std::stoull(value());
+            limited = true;
+        } else if (a == "--movetime") {
+            config.limits.time_limit_ms = std::stoll(value());
+            limited = true;
+        } else if (a == "--threads") {
+            config.threads = std::stoi(value());
+        } else if (a == "--hash") {
+            config.tt_mb = std::stoul(value());
+        } else if (a == "--min-solved") {
+            min_solved = std::stoi(value());
+        } else {
+            print_usage();
+            return 2;
+        }
+    }
+    // Without any limit the search would run to depth 64.
+    if (!limited)
+        config.limits.time_limit_ms = 1000;
+
+    std::ifstream in{std::string(args[0])};
+    if (!in)
+        throw std::runtime_error("cannot open " + std::string(args[0]));
+    const std::vector<epd::Record> records = epd::read(in);
+
+    const std::vector<epd::PositionResult> results = epd::run_suite(records, config, print_result);
+
+    int solved = 0;
+    std::int64_t total_time = 0;
+    std::int64_t solve_time = 0;
+    unsigned long long total_nodes = 0;
+    unsigned long long solve_nodes = 0;
+    for (const epd::PositionResult& r : results) {
+        total_time += r.time_ms;
+        total_nodes += r.nodes;
+        if (r.solved) {
+            ++solved;
+            solve_time += r.time_to_solution_ms;
+            solve_nodes += r.nodes_to_solution;
+        }
+    }
+    std::printf("\nSolved %d / %zu\n", solved, results.size());
+    std::printf("Total: %lld ms, %llu nodes\n", static_cast<long long>(total_time), total_nodes);
+    if (solved > 0) {
+        std::printf("Mean to solution: %.1f ms, %.0f nodes\n",
+                    static_cast<double>(solve_time) / solved,
+                    static_cast<double>(solve_nodes) / solved);
+    }
+    return solved < min_solved ? 1 : 0;
+}
+
+}  // namespace
+
+int main(int argc, char** argv) {
+    chessie::magic::init();
+    std::vector<std::string_view> args(argv + 1, argv + argc);
+    try {
+        return run(args);
+    } catch (const std::exception& e) {
+        std::fprintf(stderr, "error: %s\n", e.what());
+        return 1;
+    }
+}
@@ -0,0 +1,203 @@
+/// @file match.cpp
+/// `chessie_match`: engine-vs-engine matches with optional SPRT.
+///
+/// Usage:
+///   chessie_match --engine name=A depth=8 [...] --engine name=B nodes=20000 [...]
+///                 [--games N] [--concurrency N] [--openings FILE] [--pgn FILE]
+///                 [--summary FILE] [--max-plies N]
+///                 [--sprt elo0=0 elo1=5 alpha=0.05 beta=0.05]
+///
+/// Engine options: name=S depth=N nodes=N movetime=MS tc=SECONDS[+INC]
+///                 hash=MB aging=on|off
+
+#include <chessie/magic.hpp>
+#include <chessie/match.hpp>
+
+#include <cstdio>
+#include <exception>
+#include <fstream>
+#include <stdexcept>
+#include <string>
+#include <string_view>
+#include <utility>
+#include <vector>
+
+namespace {
+
+using namespace chessie;
+
+void print_usage() {
+    std::fprintf(
+        stderr,
+        "usage:\n"
+        "  chessie_match --engine OPTS... --engine OPTS... [--games N] [--concurrency N]\n"
+        "                [--openings FILE] [--pgn FILE] [--summary FILE] [--max-plies N]\n"
+        "                [--sprt elo0=0 elo1=5 alpha=0.05 beta=0.05]\n"
+        "engine options: name=S depth=N nodes=N movetime=MS tc=SECONDS[+INC] hash=MB\n"
+        "                aging=on|off\n");
+}
+
+/// Split "key=value"; throws on a missing '='.
+std::pair<std::string_view, std::string> split_option(std::string_view arg) {
+    const auto eq = arg.find('=');
+    if (eq == std::string_view::npos)
+        throw std::invalid_argument("expected key=value, got '" + std::string(arg) + "'");
+    return {arg.substr(0, eq), std::string(arg.substr(eq + 1))};
+}
+
+void apply_engine_option(match::EngineConfig& config, std::string_view arg) {
+    auto [key, value] = split_option(arg);
+    if (key == "name") {
+        config.name = value;
+    } else if (key == "depth") {
+        config.limits.max_depth = std::stoi(value);
+    } else if (key == "nodes") {
+        config.limits.max_nodes = std::stoull(value);
+    } else if (key == "movetime") {
+        config.limits.time_limit_ms = std::stoll(value);
+    } else if (key == "tc") {
+        const auto plus = value.find('+');
+        config.base_ms = static_cast<std::int64_t>(std::stod(value.substr(0, plus)) * 1000.0);
+        if (plus != std::string::npos)
+            config.inc_ms = static_cast<std::int64_t>(std::stod(value.substr(plus + 1)) * 1000.0);
+    } else if (key == "hash") {
+        config.tt_mb = std::stoul(value);
+    } else if (key == "aging") {
+        config.heuristic_aging = value == "on" || value == "1" || value == "true";
+    } else {
+        throw std::invalid_argument("unknown engine option '" + std::string(key) + "'");
+    }
+}
+
+void apply_sprt_option(match::SprtConfig& config, std::string_view arg) {
+    auto [key, value] = split_option(arg);
+    const double x = std::stod(value);
+    if (key == "elo0") {
+        config.elo0 = x;
+    } else if (key == "elo1") {
+        config.elo1 = x;
+    } else if (key == "alpha") {
+        config.alpha = x;
+    } else if (key == "beta") {
+        config.beta = x;
+    } else {
+        throw std::invalid_argument("unknown SPRT option '" + std::string(key) + "'");
+    }
+}
+
+std::string summary_text(const match::MatchConfig& config, const match::MatchResult& result) {
+    const match::Tally& t = result.tally;
+    char buf[256];
+    std::string out;
+    std::snprintf(buf, sizeof(buf), "Score of %s vs %s: %d - %d - %d  [%.3f] %d\n",
+                  config.first.name.c_str(), config.second.name.c_str(), t.wins, t.losses, t.draws,
+                  t.score(), t.games());
+    out += buf;
+    std::snprintf(buf, sizeof(buf), "Elo difference: %.1f +/- %.1f\n",
+                  match::elo_from_score(t.score()), match::elo_error_95(t));
+    out += buf;
+    if (config.sprt) {
+        const char* verdict = "inconclusive";
+        if (result.decision == match::SprtDecision::AcceptH0)
+            verdict = "H0 accepted";
+        if (result.decision == match::SprtDecision::AcceptH1)
+            verdict = "H1 accepted";
+        std::snprintf(buf, sizeof(buf), "SPRT [%.1f, %.1f]: LLR %.2f, %s\n", config.sprt->elo0,
+                      config.sprt->elo1, result.llr, verdict);
+        out += buf;
+    }
+    return out;
+}
+
+int run(const std::vector<std::string_view>& args) {
+    match::MatchConfig config;
+    config.first.name = "first";
+    config.second.name = "second";
+    std::string pgn_path;
+    std::string summary_path;
+    int engines_seen = 0;
+
+    // Option groups: "--engine" and "--sprt" consume key=value words up to
+    // the next "--" flag.
+    for (std::size_t i = 0; i < args.size(); ++i) {
+        std::string_view a = args[i];
+        auto value = [&]() -> std::string {
+            if (i + 1 >= args.size()) {
+                throw std::invalid_argument("missing value for " + std::string(a));
+            }
+            return std::string(args[++i]);
+        };
+        auto group = [&](auto&& apply) {
+            while (i + 1 < args.size() && args[i + 1].substr(0, 2) != "--") apply(args[++i]);
+        };
+        if (a == "--engine") {
+            if (engines_seen == 2)
+                throw std::invalid_argument("more than two --engine groups");
+            match::EngineConfig& engine = engines_seen++ == 0 ? config.first : config.second;
+            group([&](std::string_view opt) { apply_engine_option(engine, opt); });
+        } else if (a == "--sprt") {
+            config.sprt.emplace();
+            group([&](std::string_view opt) { apply_sprt_option(*config.sprt, opt); });
+        } else if (a == "--games") {
+            config.games = std::stoi(value());
+        } else if (a == "--concurrency") {
+            config.concurrency = std::stoi(value());
+        } else if (a == "--max-plies") {
+            config.max_plies = std::stoi(value());
+        } else if (a == "--openings") {
+            std::ifstream in(value());
+            if (!in)
+                throw std::runtime_error("cannot open openings file");
+            config.openings = match::read_openings(in);
+        } else if (a == "--pgn") {
+            pgn_path = value();
+        } else if (a == "--summary") {
+            summary_path = value();
+        } else {
+            print_usage();
+            return 2;
+        }
+    }
+    if (engines_seen != 2) {
+        print_usage();
+        return 2;
+    }
+
+    std::ofstream pgn;
+    if (!pgn_path.empty()) {
+        pgn.open(pgn_path);
+        if (!pgn)
+            throw std::runtime_error("cannot open " + pgn_path);
+    }
+
+    match::MatchResult result =
+        match::run_match(config, [&](const match::GameRecord& game, const match::Tally& tally) {
+            if (pgn.is_open())
+                pgn << match::to_pgn(game) << std::flush;
+            std::printf("game %4d  %-7s %-28s  score %d - %d - %d\n", game.round,
+                        std::string(match::result_string(game.outcome)).c_str(),
+                        game.termination.c_str(), tally.wins, tally.losses, tally.draws);
+            std::fflush(stdout);
+        });
+
+    const std::string summary = summary_text(config, result);
+    std::printf("\n%s", summary.c_str());
+    if (!summary_path.empty()) {
+        std::ofstream out(summary_path);
+        out << summary;
+    }
+    return 0;
+}
+
+}  // namespace
+
+int main(int argc, char** argv) {
+    chessie::magic::init();
+    std::vector<std::string_view> args(argv + 1, argv + argc);
+    try {
+        return run(args);
+    } catch (const std::exception& e) {
+        std::fprintf(stderr, "error: %s\n", e.what());
+        return 1;
+    }
+}
@@ -0,0 +1,159 @@
+/// @file tune.cpp
+/// `chessie_tune`: Texel tuning of the evaluation parameters.
+///
+/// Usage:
+///   chessie_tune convert <positions.txt> <dataset.bin>
+///   chessie_tune tune <dataset.bin> [--params FILE] [--out FILE] [--export FILE]
+///                     [--epochs N] [--lr X] [--k K] [--threads N] [--no-mmap]
+
+#include <chessie/evaluation.hpp>
+#include <chessie/magic.hpp>
+#include <chessie/tuner.hpp>
+
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <exception>
+#include <fstream>
+#include <stdexcept>
+#include <string>
+#include <string_view>
+#include <vector>
+
+namespace {
+
+using namespace chessie;
+
+void print_usage() {
+    std::fprintf(stderr,
+                 "usage:\n"
+                 "  chessie_tune convert <positions.txt> <dataset.bin>\n"
+                 "  chessie_tune tune <dataset.bin> [--params FILE] [--out FILE] [--export FILE]\n"
+                 "                    [--epochs N] [--lr X] [--k K] [--threads N] [--no-mmap]\n");
+}
+
+int run_convert(const std::vector<std::string_view>& args) {
+    if (args.size() != 2) {
+        print_usage();
+        return 2;
+    }
+    std::ifstream in{std::string(args[0])};
+    std::ofstream out{std::string(args[1]), std::ios::binary};
+    if (!in || !out) {
+        std::fprintf(stderr, "cannot open input or output file\n");
+        return 1;
+    }
+    std::size_t n = tune::convert_text(in, out);
+    std::printf("wrote %zu positions\n", n);
+    return 0;
+}
+
+int run_tune(const std::vector<std::string_view>& args) {
+    if (args.empty()) {
+        print_usage();
+        return 2;
+    }
+    std::string dataset_path(args[0]);
+    std::string params_path;
+    std::string out_path = "tuned_params.txt";
+    std::string export_path;
+    int epochs = 1000;
+    double lr = 1.0;
+    double k = 0.0;
+    int threads = 0;
+    bool use_mmap = true;
+
+    for (std::size_t i = 1; i < args.size(); ++i) {
+        std::string_view a = args[i];
+        auto value = [&]() -> std::string {
+            if (i + 1 >= args.size()) {
+                throw std::invalid_argument("missing value for " + std::string(a));
+            }
+            return std::string(args[++i]);
+        };
+        if (a == "--params") {
+            params_path = value();
+        } else if (a == "--out") {
+            out_path = value();
+        } else if (a == "--export") {
+            export_path = value();
+        } else if (a == "--epochs") {
+            epochs = std::stoi(value());
+        } else if (a == "--lr") {
+            lr = std::stod(value());
+        } else if (a == "--k") {
+            k = std::stod(value());
+        } else if (a == "--threads") {
+            threads = std::stoi(value());
+        } else if (a == "--no-mmap") {
+            use_mmap = false;
+        } else {
+            print_usage();
+            return 2;
+        }
+    }
+
+    eval::Params initial = eval::default_params();
+    if (!params_path.empty()) {
+        eval::load_params_file(params_path, initial);
+    }
+
+    tune::Dataset dataset(dataset_path, use_mmap);
+    auto t0 = std::chrono::steady_clock::now();
+    tune::Tuner tuner(dataset.positions(), initial, threads);
+    auto t1 = std::chrono::steady_clock::now();
+    std::printf("traced %zu positions (%s) on %d threads in %.2fs\n", tuner.size(),
+                dataset.mapped() ? "mmap" : "read", tuner.threads(),
+                std::chrono::duration<double>(t1 - t0).count());
+
+    if (k <= 0.0) {
+        k = tuner.find_k();
+    }
+    std::printf("K = %.4f, initial error = %.8f\n", k, tuner.error(k));
+
+    auto save = [&]() {
+        eval::Params tuned = tuner.params();
+        std::ofstream out(out_path);
+        eval::save_params(out, tuned);
+        if (!export_path.empty()) {
+            std::ofstream exp(export_path);
+            eval::export_cpp(exp, tuned);
+        }
+    };
+
+    for (int epoch = 1; epoch <= epochs; ++epoch) {
+        double err = tuner.step(k, lr);
+        if (epoch % 50 == 0 || epoch == epochs) {
+            std::printf("epoch %5d  error %.8f\n", epoch, err);
+            std::fflush(stdout);
+            save();
+        }
+    }
+    std::printf("final error = %.8f, parameters written to %s\n", tuner.error(k),
+                out_path.c_str());
+    return 0;
+}
+
+}  // namespace
+
+int main(int argc, char** argv) {
+    if (argc < 2) {
+        print_usage();
+        return 2;
+    }
+    chessie::magic::init();
+
+    std::string_view command = argv[1];
+    std::vector<std::string_view> args(argv + 2, argv + argc);
+    try {
+        if (command == "convert")
+            return run_convert(args);
+        if (command == "tune")
+            return run_tune(args);
+    } catch (const std::exception& e) {
+        std::fprintf(stderr, "error: %s\n", e.what());
+        return 1;
+    }
+    print_usage();
+    return 2;
+}
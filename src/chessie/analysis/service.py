@@ -15,7 +15,7 @@ from chessie.analysis.models import (
 )
 from chessie.core.enums import Color, MoveFlag
 from chessie.core.notation import move_to_san, position_from_fen
-from chessie.engine._default import DefaultEngine
+from chessie.engine._default import ANALYSIS_CONTEXT, shared_engine
 from chessie.engine.search import CancelCheck, IEngine, SearchLimits
 
 if TYPE_CHECKING:
@@ -55,7 +55,7 @@ class GameAnalyzer:
     __slots__ = ("_engine",)
 
     def __init__(self, engine: IEngine | None = None) -> None:
-        self._engine = engine or DefaultEngine()
+        self._engine = engine or shared_engine(ANALYSIS_CONTEXT)
 
     def analyze_game(
         self,
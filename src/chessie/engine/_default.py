@@ -6,9 +6,34 @@ here instead of from each other, breaking the import cycle.
 
 from __future__ import annotations
 
-from chessie.engine.cpp_search import CppSearchEngine
+import threading
+
+from chessie.engine.cpp_search import CppEnginePool, CppSearchEngine
 from chessie.engine.search import IEngine
 
 DefaultEngine: type[IEngine] = CppSearchEngine
 
-__all__ = ["DefaultEngine"]
+# Search contexts of the process-wide pool.
+PLAY_CONTEXT = 0
+ANALYSIS_CONTEXT = 1
+
+_SHARED_POOL_MB = 64
+
+_pool: CppEnginePool | None = None
+_pool_lock = threading.Lock()
+
+
+def shared_engine(context: int) -> IEngine:
+    """Return an engine on *context* of the process-wide pool.
+
+    Play and analysis use separate contexts that share one transposition
+    table, so the app holds a single table instead of one per engine.
+    """
+    global _pool
+    with _pool_lock:
+        if _pool is None:
+            _pool = CppEnginePool(budget_mb=_SHARED_POOL_MB, contexts=2)
+        return _pool.engine(context)
+
+
+__all__ = ["ANALYSIS_CONTEXT", "PLAY_CONTEXT", "DefaultEngine", "shared_engine"]
@@ -6,7 +6,7 @@ tuples to keep Python/C++ mapping simple and deterministic.
 
 from __future__ import annotations
 
-from typing import TYPE_CHECKING
+from typing import TYPE_CHECKING, Any
 
 from chessie.core.enums import MoveFlag, PieceType
 from chessie.core.move import Move
@@ -15,6 +15,8 @@ from chessie.core.notation import position_to_fen
 from chessie.engine.search import CancelCheck, IEngine, SearchLimits, SearchResult
 
 if TYPE_CHECKING:
+    from collections.abc import Callable
+
     from chessie.core.position import Position
 
 try:
@@ -62,22 +64,107 @@ def is_available() -> bool:
     return _chessie_engine is not None
 
 
+def _require_native() -> None:
+    if _chessie_engine is None:
+        msg = (
+            "Native C++ engine module (_chessie_engine) is not available. "
+            "Build/install Chessie with BUILD_PYBIND=ON."
+        )
+        raise ImportError(msg)
+
+
+def _result_from_native(
+    native_result: tuple[Any, ...], position: Position
+) -> SearchResult:
+    best_move: Move | None
+
+    if len(native_result) == 8:
+        (
+            has_move,
+            from_sq,
+            to_sq,
+            move_flag,
+            promotion,
+            score_cp,
+            depth,
+            nodes,
+        ) = native_result
+        best_move = None
+        if has_move:
+            promo = PieceType(promotion) if promotion else None
+            best_move = Move(from_sq, to_sq, MoveFlag(move_flag), promo)
+    elif len(native_result) == 4:
+        uci_move, score_cp, depth, nodes = native_result
+        best_move = _legacy_uci_to_move(uci_move, position)
+    else:
+        raise RuntimeError(
+            "Unsupported _chessie_engine.search result format. "
+            "Rebuild native module with current bindings."
+        )
+
+    return SearchResult(
+        best_move=best_move,
+        score_cp=score_cp,
+        depth=depth,
+        nodes=nodes,
+    )
+
+
+class CppSearchHandle:
+    """A search running on a :class:`CppSearchEngine`'s own thread."""
+
+    __slots__ = ("_handle", "_position")
+
+    def __init__(self, handle: Any, position: Position) -> None:
+        self._handle = handle
+        self._position = position
+
+    def poll(self) -> bool:
+        """Return *True* once the search has finished."""
+        return bool(self._handle.poll())
+
+    def stop(self) -> None:
+        """Ask the search to stop; returns immediately."""
+        self._handle.stop()
+
+    def wait(self, timeout: float | None = None) -> bool:
+        """Block until finished or *timeout* seconds pass; return *True* if finished."""
+        return bool(self._handle.wait(timeout))
+
+    def result(self) -> SearchResult | None:
+        """Return the search result, or *None* while the search is running.
+
+        Raises the native search's error (e.g. ``MemoryError``) if it failed.
+        """
+        native_result = self._handle.result()
+        if native_result is None:
+            return None
+        return _result_from_native(native_result, self._position)
+
+
 class CppSearchEngine(IEngine):
     """Chess engine backed by the native C++ search.
 
     Implements the :class:`IEngine` protocol used by the application.
     """
 
-    __slots__ = ("_engine",)
+    __slots__ = ("_engine", "_pool")
 
-    def __init__(self, *, tt_mb: int = 64) -> None:
-        if _chessie_engine is None:
-            msg = (
-                "Native C++ engine module (_chessie_engine) is not available. "
-                "Build/install Chessie with BUILD_PYBIND=ON."
-            )
-            raise ImportError(msg)
-        self._engine: _chessie_engine.Engine = _chessie_engine.Engine(tt_mb)
+    def __init__(
+        self,
+        *,
+        tt_mb: int = 64,
+        pool: CppEnginePool | None = None,
+        context: int = 0,
+    ) -> None:
+        """Own a *tt_mb* table, or drive *context* of *pool* and share its table."""
+        self._pool = pool
+        self._engine: _chessie_engine.Engine
+        if pool is not None:
+            self._engine = pool.native_engine(context)
+        else:
+            _require_native()
+            self._engine = _chessie_engine.Engine(tt_mb)
 
     # ── IEngine protocol ─────────────────────────────────────────────────
 
@@ -104,49 +191,91 @@ class CppSearchEngine(IEngine):
             limits.max_depth,
             time_ms,
         )
-        best_move: Move | None
-
-        if len(native_result) == 8:
-            (
-                has_move,
-                from_sq,
-                to_sq,
-                move_flag,
-                promotion,
-                score_cp,
-                depth,
-                nodes,
-            ) = native_result
-            best_move = None
-            if has_move:
-                promo = PieceType(promotion) if promotion else None
-                best_move = Move(from_sq, to_sq, MoveFlag(move_flag), promo)
-        elif len(native_result) == 4:
-            uci_move, score_cp, depth, nodes = native_result
-            best_move = _legacy_uci_to_move(uci_move, position)
-        else:
-            raise RuntimeError(
-                "Unsupported _chessie_engine.search result format. "
-                "Rebuild native module with current bindings."
-            )
-
-        return SearchResult(
-            best_move=best_move,
-            score_cp=score_cp,
-            depth=depth,
-            nodes=nodes,
+        return _result_from_native(native_result, position)
+
+    # ── Asynchronous search ──────────────────────────────────────────────
+
+    def start_search(
+        self,
+        position: Position,
+        limits: SearchLimits,
+        on_done: Callable[[SearchResult], None] | None = None,
+    ) -> CppSearchHandle:
+        """Start searching *position* on the engine's own thread.
+
+        Returns at once with a handle to poll, stop or wait on. A search
+        still running on this engine is stopped first. *on_done* is called
+        with the result on the search thread once the handle has finished.
+        """
+        fen = position_to_fen(position)
+        time_ms = limits.time_limit_ms if limits.time_limit_ms is not None else -1
+        callback = None
+        if on_done is not None:
+
+            def callback(native_result: tuple[Any, ...]) -> None:
+                on_done(_result_from_native(native_result, position))
+
+        handle = self._engine.start_search(
+            fen, limits.max_depth, time_ms, on_done=callback
         )
+        return CppSearchHandle(handle, position)
 
     # ── Extra controls ───────────────────────────────────────────────────
 
+    def last_stats(self) -> dict[str, object]:
+        """Return search statistics counters of the most recent search."""
+        return dict(self._engine.last_stats())
+
     def cancel(self) -> None:
         """Cancel a running search (thread-safe)."""
         self._engine.cancel()
 
+    def set_heuristic_aging(self, enabled: bool) -> None:
+        """Age killers/history between searches of one game instead of clearing."""
+        self._engine.set_heuristic_aging(enabled)
+
     def set_tt_size(self, mb: int) -> None:
-        """Resize the transposition table (clears it)."""
+        """Resize the transposition table, keeping its entries where possible."""
         self._engine.set_tt_size(mb)
 
     def clear_tt(self) -> None:
         """Clear the transposition table."""
         self._engine.clear_tt()
+
+
+class CppEnginePool:
+    """Native search contexts sharing one transposition table.
+
+    The table and every context's own state fit in *budget_mb* megabytes,
+    so play and analysis share learned entries without each allocating a
+    full table.
+    """
+
+    __slots__ = ("_pool",)
+
+    def __init__(self, *, budget_mb: int = 64, contexts: int = 2) -> None:
+        _require_native()
+        self._pool = _chessie_engine.EnginePool(budget_mb, contexts)
+
+    def __len__(self) -> int:
+        return len(self._pool)
+
+    def engine(self, context: int) -> CppSearchEngine:
+        """Return an :class:`IEngine` driving search context *context*."""
+        return CppSearchEngine(pool=self, context=context)
+
+    def native_engine(self, context: int) -> Any:
+        """Return the native engine of search context *context*."""
+        return self._pool.engine(context)
+
+    def memory_bytes(self) -> int:
+        """Bytes charged to the shared table and all contexts."""
+        return int(self._pool.memory_bytes())
+
+    def set_budget(self, mb: int) -> None:
+        """Change the memory budget, keeping the shared table's entries."""
+        self._pool.set_budget(mb)
+
+    def clear_tt(self) -> None:
+        """Clear the shared transposition table."""
+        self._pool.clear_tt()
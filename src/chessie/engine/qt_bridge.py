@@ -8,7 +8,7 @@ from typing import TYPE_CHECKING
 from PyQt6.QtCore import QObject, pyqtSignal, pyqtSlot
 
 from chessie.core.position import Position
-from chessie.engine._default import DefaultEngine
+from chessie.engine._default import PLAY_CONTEXT, shared_engine
 from chessie.engine.search import SearchLimits
 
 if TYPE_CHECKING:
@@ -45,7 +45,7 @@ class EngineWorker(QObject):
 
         if self._engine is None:
             try:
-                self._engine = DefaultEngine()
+                self._engine = shared_engine(PLAY_CONTEXT)
             except Exception as exc:
                 self.search_error.emit(request_id, str(exc))
                 return
@@ -17,7 +17,7 @@ from chessie.engine.search import SearchLimits, SearchResult
 if TYPE_CHECKING:
     pass
 
-from chessie.engine.cpp_search import CppSearchEngine, is_available
+from chessie.engine.cpp_search import CppEnginePool, CppSearchEngine, is_available
 
 if not is_available():
     pytest.skip(
@@ -191,6 +191,46 @@ class TestCppSearchEngine:
         assert result.depth > 0
         assert elapsed < 2.0
 
+    # ── asynchronous search ──────────────────────────────────────────────
+
+    def test_start_search_reports_completion(self, engine: CppSearchEngine) -> None:
+        pos = position_from_fen(STARTING_FEN)
+        done: list[SearchResult] = []
+
+        handle = engine.start_search(pos, NO_TIME_LIMIT, on_done=done.append)
+        assert handle.wait(timeout=10)
+        assert handle.poll()
+        result = handle.result()
+        assert result is not None
+        assert result.depth == 3
+        assert done == [result]
+
+    def test_start_search_can_be_stopped(self, engine: CppSearchEngine) -> None:
+        pos = position_from_fen(STARTING_FEN)
+        limits = SearchLimits(max_depth=64, time_limit_ms=None)
+        handle = engine.start_search(pos, limits)
+        assert handle.result() is None or handle.poll()
+        handle.stop()
+        assert handle.wait(timeout=5)
+        result = handle.result()
+        assert result is not None
+        assert result.depth < 20
+
+    # ── shared pool ──────────────────────────────────────────────────────
+
+    def test_pool_contexts_share_table(self) -> None:
+        pool = CppEnginePool(budget_mb=8, contexts=2)
+        assert len(pool) == 2
+        assert pool.memory_bytes() <= 8 * 1024 * 1024
+
+        pos = position_from_fen(STARTING_FEN)
+        limits = SearchLimits(max_depth=5, time_limit_ms=None)
+        cold = CppSearchEngine(tt_mb=8).search(pos, limits)
+        pool.engine(0).search(pos, limits)
+        warm = pool.engine(1).search(pos, limits)
+        assert warm.best_move is not None
+        assert warm.nodes < cold.nodes
+
     # ── engine controls ──────────────────────────────────────────────────
 
     def test_set_tt_size(self, engine: CppSearchEngine) -> None: